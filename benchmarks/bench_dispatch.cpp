@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <tio/dispatch.hpp>
+#include <tio/event.hpp>
+
+#include <benchmark/benchmark.h>
+
+using tio::batch_dispatcher;
+using tio::event;
+using tio::events;
+using tio::token;
+
+namespace {
+
+constexpr std::size_t k_slab_size = 1 << 20;
+constexpr std::size_t k_batches = 64;
+
+struct alignas(64) conn_state {
+  std::uint64_t bytes_in;
+  std::uint64_t last_seen;
+  std::uint8_t pad[48];
+};
+
+// Cycles through many random batches over a slab far larger than the
+// caches, so each handler sees a cold connection like in a busy server.
+struct fixture {
+  std::vector<conn_state> slab;
+  std::vector<events> batches;
+  std::size_t next = 0;
+
+  explicit fixture(std::size_t batch) : slab(k_slab_size) {
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<std::size_t> pick{0, k_slab_size - 1};
+    batches.reserve(k_batches);
+    for (std::size_t b = 0; b < k_batches; ++b) {
+      auto& evs = batches.emplace_back(batch);
+      for (std::size_t i = 0; i < batch; ++i) {
+        evs.raw_buf()[i].data.u64 = pick(rng);
+        evs.raw_buf()[i].events = EPOLLIN;
+      }
+      evs.set_len(batch);
+    }
+  }
+
+  auto batch() -> const events& { return batches[next++ % k_batches]; }
+};
+
+void handle(const event& ev, conn_state& st) {
+  st.bytes_in += ev.is_readable() ? 1 : 0;
+  st.last_seen = ev.tok().value();
+}
+
+// Handler with a dependent compute chain long enough to fill the
+// out-of-order window, so the next event's miss is no longer overlapped.
+auto heavy_handler(std::int64_t work) {
+  return [work](const event& ev, conn_state& st) {
+    auto h = st.last_seen ^ ev.tok().value();
+    for (std::int64_t i = 0; i < work; ++i) {
+      h = h * 0x9e3779b97f4a7c15ULL + 1;
+    }
+    st.last_seen = h;
+    st.bytes_in += 1;
+  };
+}
+
+void bm_dispatch_range_for(benchmark::State& state) {
+  fixture f{static_cast<std::size_t>(state.range(0))};
+
+  for (auto _ : state) {
+    for (const auto& ev : f.batch()) {
+      handle(ev, f.slab[ev.tok().value()]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bm_dispatch_batched(benchmark::State& state) {
+  fixture f{static_cast<std::size_t>(state.range(0))};
+  batch_dispatcher<conn_state> d{
+    static_cast<std::size_t>(state.range(0)),
+    static_cast<std::size_t>(state.range(1))
+  };
+
+  for (auto _ : state) {
+    d.dispatch(f.batch(), [&](token t) { return &f.slab[t.value()]; }, handle);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bm_dispatch_range_for_heavy(benchmark::State& state) {
+  fixture f{1024};
+  auto h = heavy_handler(state.range(0));
+
+  for (auto _ : state) {
+    for (const auto& ev : f.batch()) {
+      h(ev, f.slab[ev.tok().value()]);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+void bm_dispatch_batched_heavy(benchmark::State& state) {
+  fixture f{1024};
+  batch_dispatcher<conn_state> d{1024};
+  auto h = heavy_handler(state.range(0));
+
+  for (auto _ : state) {
+    d.dispatch(f.batch(), [&](token t) { return &f.slab[t.value()]; }, h);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+void bm_dispatch_grouped(benchmark::State& state) {
+  fixture f{static_cast<std::size_t>(state.range(0))};
+  batch_dispatcher<conn_state> d{static_cast<std::size_t>(state.range(0))};
+
+  for (auto _ : state) {
+    d.dispatch_grouped<2>(
+      f.batch(),
+      [](const event& ev, const conn_state*) { return ev.tok().value() & 1; },
+      [&](token t) { return &f.slab[t.value()]; },
+      handle
+    );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(bm_dispatch_range_for)->Arg(64)->Arg(1024)->Arg(4096);
+BENCHMARK(bm_dispatch_batched)->ArgsProduct({{64, 1024, 4096}, {2, 4, 8, 16}});
+BENCHMARK(bm_dispatch_range_for_heavy)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK(bm_dispatch_batched_heavy)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK(bm_dispatch_grouped)->Arg(64)->Arg(1024)->Arg(4096);
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <cstdint>
+
+#include <sys/epoll.h>
+
+#include <tio/event.hpp>
+
+#include <benchmark/benchmark.h>
+
+using tio::events;
+
+namespace {
+
+auto filled(std::size_t n) -> events {
+  events evs{n};
+  for (std::size_t i = 0; i < n; ++i) {
+    evs.raw_buf()[i].data.u64 = i;
+    evs.raw_buf()[i].events = (i & 1) != 0 ? EPOLLIN : EPOLLIN | EPOLLOUT;
+  }
+  evs.set_len(n);
+  return evs;
+}
+
+// Decoding cost of walking a full batch: token plus readiness bits.
+void bm_events_iterate(benchmark::State& state) {
+  const auto evs = filled(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (const auto& ev : evs) {
+      sum += ev.tok().value() + (ev.is_readable() ? 1 : 0) + (ev.is_writable() ? 2 : 0);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bm_events_index(benchmark::State& state) {
+  const auto evs = filled(static_cast<std::size_t>(state.range(0)));
+
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < evs.size(); ++i) {
+      sum += evs[i].tok().value() + (evs[i].is_readable() ? 1 : 0);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(bm_events_iterate)->Arg(64)->Arg(1024)->Arg(4096);
+BENCHMARK(bm_events_index)->Arg(64)->Arg(1024)->Arg(4096);
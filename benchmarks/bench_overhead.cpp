@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+// Identical workloads through hand-written epoll/recv/send and through tio.
+// Each raw/tio pair reports time plus `insns`, the user-space instructions
+// retired per iteration (perf_event_open; omitted when perf events are not
+// permitted). Kernel work is excluded, so the insns delta between a pair is
+// the abstraction's own cost.
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <tio/event.hpp>
+#include <tio/interest.hpp>
+#include <tio/net/tcp_listener.hpp>
+#include <tio/net/tcp_stream.hpp>
+#include <tio/poll.hpp>
+#include <tio/sys/detail/fd_guard.hpp>
+#include <tio/token.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.hpp"
+
+using namespace std::chrono_literals;
+
+using tio::clock_mode;
+using tio::events;
+using tio::interest;
+using tio::poll;
+using tio::poll_options;
+using tio::token;
+using tio::bench::make_eventfds;
+using tio::detail::fd_guard;
+using tio::net::tcp_listener;
+using tio::net::tcp_stream;
+
+namespace {
+
+// User-space instructions retired by this thread between start() and stop().
+class insn_counter {
+public:
+  insn_counter() {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = fd_guard{static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0))};
+  }
+
+  void start() const {
+    if (fd_.raw_fd() >= 0) {
+      ::ioctl(fd_.raw_fd(), PERF_EVENT_IOC_RESET, 0);
+      ::ioctl(fd_.raw_fd(), PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+
+  // Adds the per-iteration count to the state's counters.
+  void stop(benchmark::State& state) const {
+    if (fd_.raw_fd() < 0) {
+      return;
+    }
+    ::ioctl(fd_.raw_fd(), PERF_EVENT_IOC_DISABLE, 0);
+    std::uint64_t n = 0;
+    if (::read(fd_.raw_fd(), &n, sizeof(n)) == sizeof(n)) {
+      state.counters["insns"] = benchmark::Counter(static_cast<double>(n), benchmark::Counter::kAvgIterations);
+    }
+  }
+
+private:
+  fd_guard fd_;
+};
+
+void signal_all(const std::vector<fd_guard>& fds) {
+  const std::uint64_t one = 1;
+  for (const auto& fd : fds) {
+    benchmark::DoNotOptimize(::write(fd.raw_fd(), &one, sizeof(one)));
+  }
+}
+
+auto tcp_pair() -> std::pair<tcp_stream, tcp_stream> {
+  auto l = tcp_listener::bind(tio::detail::socket_addr::ipv4_loopback(0)).value();
+  auto c = tcp_stream::connect(l.local_addr().value()).value();
+  while (true) {
+    if (auto a = l.accept(); a.has_value()) {
+      (void)c.set_nodelay(true);
+      return {std::move(c), std::move(a->first)};
+    }
+  }
+}
+
+// Empty zero-timeout wait. tio adds the per-iteration clock sample;
+// range(0) selects precise (0) or coarse (1) clock mode.
+void bm_overhead_wait_empty_raw(benchmark::State& state) {
+  const fd_guard ep{::epoll_create1(EPOLL_CLOEXEC)};
+  std::array<epoll_event, 64> evs{};
+  insn_counter insns;
+
+  insns.start();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(::epoll_wait(ep.raw_fd(), evs.data(), static_cast<int>(evs.size()), 0));
+  }
+  insns.stop(state);
+}
+
+void bm_overhead_wait_empty_tio(benchmark::State& state) {
+  auto p = poll::create(poll_options{.clock = state.range(0) != 0 ? clock_mode::coarse : clock_mode::precise})
+             .value();
+  events evs{64};
+  insn_counter insns;
+
+  insns.start();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p.do_poll(evs, 0ms));
+  }
+  insns.stop(state);
+}
+
+// N edge-triggered eventfds made ready before each wait, then every event
+// is visited for its token and readiness. The signalling writes are
+// outside the timed region but inside the insns count, equally on both
+// sides.
+void bm_overhead_wait_ready_raw(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  const fd_guard ep{::epoll_create1(EPOLL_CLOEXEC)};
+  auto fds = make_eventfds(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    epoll_event ev{.events = EPOLLIN | EPOLLRDHUP | EPOLLET, .data = {.u64 = i}};
+    ::epoll_ctl(ep.raw_fd(), EPOLL_CTL_ADD, fds[i].raw_fd(), &ev);
+  }
+  std::vector<epoll_event> evs(n);
+  insn_counter insns;
+
+  insns.start();
+  for (auto _ : state) {
+    state.PauseTiming();
+    signal_all(fds);
+    state.ResumeTiming();
+
+    const int got = ::epoll_wait(ep.raw_fd(), evs.data(), static_cast<int>(n), 0);
+    std::uint64_t sum = 0;
+    for (int i = 0; i < got; ++i) {
+      sum += (evs[i].events & EPOLLIN) != 0 ? evs[i].data.u64 : 0;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  insns.stop(state);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bm_overhead_wait_ready_tio(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto p = poll::create().value();
+  auto reg = p.get_registry();
+  auto fds = make_eventfds(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    (void)reg.register_fd(fds[i].raw_fd(), token{i}, interest::readable());
+  }
+  events evs{n};
+  insn_counter insns;
+
+  insns.start();
+  for (auto _ : state) {
+    state.PauseTiming();
+    signal_all(fds);
+    state.ResumeTiming();
+
+    (void)p.do_poll(evs, 0ms);
+    std::uint64_t sum = 0;
+    for (const auto& ev : evs) {
+      sum += ev.is_readable() ? ev.tok().value() : 0;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  insns.stop(state);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// One range(0)-byte send and the matching recv over loopback TCP; no
+// readiness wait, only the I/O call path and its error handling.
+void bm_overhead_send_recv_raw(benchmark::State& state) {
+  auto [client, server] = tcp_pair();
+  const auto size = static_cast<std::size_t>(state.range(0));
+  std::vector<std::byte> out(size, std::byte{'x'});
+  std::vector<std::byte> in(size);
+  insn_counter insns;
+
+  insns.start();
+  for (auto _ : state) {
+    const ssize_t w = ::send(client.raw_fd(), out.data(), out.size(), MSG_NOSIGNAL);
+    if (w < 0) {
+      state.SkipWithError("send");
+      break;
+    }
+    std::size_t got = 0;
+    while (got < size) {
+      const ssize_t r = ::recv(server.raw_fd(), in.data() + got, size - got, 0);
+      if (r > 0) {
+        got += static_cast<std::size_t>(r);
+      }
+    }
+  }
+  insns.stop(state);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+void bm_overhead_send_recv_tio(benchmark::State& state) {
+  auto [client, server] = tcp_pair();
+  const auto size = static_cast<std::size_t>(state.range(0));
+  std::vector<std::byte> out(size, std::byte{'x'});
+  std::vector<std::byte> in(size);
+  insn_counter insns;
+
+  insns.start();
+  for (auto _ : state) {
+    if (!client.write(out).has_value()) {
+      state.SkipWithError("write");
+      break;
+    }
+    std::size_t got = 0;
+    while (got < size) {
+      if (auto r = server.read(std::span{in}.subspan(got)); r.has_value()) {
+        got += *r;
+      }
+    }
+  }
+  insns.stop(state);
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+BENCHMARK(bm_overhead_wait_empty_raw);
+BENCHMARK(bm_overhead_wait_empty_tio)->Arg(0)->Arg(1);
+BENCHMARK(bm_overhead_wait_ready_raw)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(bm_overhead_wait_ready_tio)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(bm_overhead_send_recv_raw)->Arg(64)->Arg(4096);
+BENCHMARK(bm_overhead_send_recv_tio)->Arg(64)->Arg(4096);
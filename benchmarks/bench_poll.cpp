@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include <unistd.h>
+
+#include <tio/event.hpp>
+#include <tio/interest.hpp>
+#include <tio/poll.hpp>
+#include <tio/sys/detail/fd_guard.hpp>
+#include <tio/sys/unix_/epoll_selector.hpp>
+#include <tio/token.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include "bench_util.hpp"
+
+using namespace std::chrono_literals;
+
+using tio::events;
+using tio::interest;
+using tio::poll;
+using tio::poll_options;
+using tio::token;
+using tio::bench::make_eventfds;
+using tio::detail::fd_guard;
+using tio::sys::unix::epoll_selector;
+
+namespace {
+
+void signal(const fd_guard& fd) {
+  const std::uint64_t one = 1;
+  benchmark::DoNotOptimize(::write(fd.raw_fd(), &one, sizeof(one)));
+}
+
+// Fixed cost of a zero-timeout poll with nothing ready: one epoll_wait
+// plus the clock sample.
+void bm_poll_empty(benchmark::State& state) {
+  auto p = poll::create().value();
+  events evs{64};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(p.do_poll(evs, 0ms));
+  }
+}
+
+void bm_selector_select_empty(benchmark::State& state) {
+  auto sel = epoll_selector::create().value();
+  events evs{64};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(sel.select(evs.raw_buf(), evs.raw_capacity(), 0ms));
+  }
+}
+
+// N registered eventfds, all made ready before each poll. Registrations
+// are edge-triggered, so every write produces a fresh event.
+void bm_poll_ready(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto p = poll::create().value();
+  auto reg = p.get_registry();
+  auto fds = make_eventfds(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    (void)reg.register_fd(fds[i].raw_fd(), token{i}, interest::readable());
+  }
+  events evs{n};
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (const auto& fd : fds) {
+      signal(fd);
+    }
+    state.ResumeTiming();
+
+    (void)p.do_poll(evs, 0ms);
+    if (evs.size() != n) {
+      state.SkipWithError("missing events");
+      break;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Registers range(0) fds, then deregisters them all; range(1) enables
+// the shadow registration table.
+void bm_register_churn(benchmark::State& state) {
+  const auto n = static_cast<std::size_t>(state.range(0));
+  auto p = poll::create(poll_options{.track_registrations = state.range(1) != 0}).value();
+  auto reg = p.get_registry();
+  auto fds = make_eventfds(n);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      benchmark::DoNotOptimize(reg.register_fd(fds[i].raw_fd(), token{i}, interest::readable()));
+    }
+    for (const auto& fd : fds) {
+      benchmark::DoNotOptimize(reg.deregister_fd(fd.raw_fd()));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bm_reregister(benchmark::State& state) {
+  auto p = poll::create(poll_options{.track_registrations = state.range(0) != 0}).value();
+  auto reg = p.get_registry();
+  auto fds = make_eventfds(1);
+  (void)reg.register_fd(fds[0].raw_fd(), token{0}, interest::readable());
+
+  std::uint64_t i = 0;
+  for (auto _ : state) {
+    // Alternating interest keeps every call a real change.
+    const auto want = (++i & 1) != 0 ? interest::writable() : interest::readable();
+    benchmark::DoNotOptimize(reg.reregister_fd(fds[0].raw_fd(), token{0}, want));
+  }
+}
+
+}
+
+BENCHMARK(bm_poll_empty);
+BENCHMARK(bm_selector_select_empty);
+BENCHMARK(bm_poll_ready)->Arg(1)->Arg(64)->Arg(1024);
+BENCHMARK(bm_register_churn)->ArgsProduct({{1, 64, 1024}, {0, 1}});
+BENCHMARK(bm_reregister)->Arg(0)->Arg(1);
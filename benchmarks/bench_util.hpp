@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <sys/eventfd.h>
+
+#include <tio/sys/detail/fd_guard.hpp>
+
+namespace tio::bench {
+
+// `n` non-blocking eventfds, the cheapest pollable source for benchmarks.
+inline auto make_eventfds(std::size_t n) -> std::vector<detail::fd_guard> {
+  std::vector<detail::fd_guard> fds;
+  fds.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    fds.emplace_back(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+  }
+  return fds;
+}
+
+}
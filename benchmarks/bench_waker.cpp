@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include <tio/event.hpp>
+#include <tio/poll.hpp>
+#include <tio/token.hpp>
+#include <tio/waker.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace std::chrono_literals;
+
+using tio::events;
+using tio::poll;
+using tio::token;
+using tio::waker;
+
+namespace {
+
+// wake() + do_poll() + drain() on one thread: the syscall floor of a wakeup.
+void bm_waker_wake_same_thread(benchmark::State& state) {
+  auto p = poll::create().value();
+  auto w = waker::create(p.get_registry(), token{0}).value();
+  events evs{8};
+
+  for (auto _ : state) {
+    (void)w.wake();
+    (void)p.do_poll(evs, 0ms);
+    w.drain();
+  }
+}
+
+// Ping-pong between two blocked polls. Each iteration is one round trip,
+// so the one-way wake latency is half the reported time.
+void bm_waker_round_trip(benchmark::State& state) {
+  auto main_poll = poll::create().value();
+  auto peer_poll = poll::create().value();
+  auto to_main = waker::create(main_poll.get_registry(), token{0}).value();
+  auto to_peer = waker::create(peer_poll.get_registry(), token{0}).value();
+  std::atomic<bool> stop{false};
+
+  std::thread peer{[&] {
+    events evs{8};
+    while (!stop.load(std::memory_order_acquire)) {
+      (void)peer_poll.do_poll(evs, 100ms);
+      if (!evs.is_empty()) {
+        to_peer.drain();
+        (void)to_main.wake();
+      }
+    }
+  }};
+
+  events evs{8};
+  for (auto _ : state) {
+    (void)to_peer.wake();
+    do {
+      (void)main_poll.do_poll(evs, std::nullopt);
+    } while (evs.is_empty());
+    to_main.drain();
+  }
+
+  stop.store(true, std::memory_order_release);
+  (void)to_peer.wake();
+  peer.join();
+}
+
+}
+
+BENCHMARK(bm_waker_wake_same_thread);
+BENCHMARK(bm_waker_round_trip)->UseRealTime();
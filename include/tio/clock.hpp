@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include <time.h>
+
+namespace tio {
+
+enum class clock_mode : std::uint8_t {
+  precise,
+  coarse,
+};
+
+// Clock sampled once per loop iteration. `now()` is a plain load, so
+// handlers can read it per event; `coarse` mode samples with
+// CLOCK_MONOTONIC_COARSE (vDSO, jiffy resolution) instead of
+// CLOCK_MONOTONIC. Both share steady_clock's epoch on Linux.
+class loop_clock {
+public:
+  using clock = std::chrono::steady_clock;
+  using time_point = clock::time_point;
+  using duration = clock::duration;
+
+  explicit loop_clock(clock_mode mode = clock_mode::precise) noexcept
+    : now_{sample(mode)}, mode_{mode} {}
+
+  [[nodiscard]] static auto sample(clock_mode mode) noexcept -> time_point {
+    timespec ts{};
+    ::clock_gettime(mode == clock_mode::coarse ? CLOCK_MONOTONIC_COARSE : CLOCK_MONOTONIC, &ts);
+    return time_point{std::chrono::duration_cast<duration>(
+      std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec}
+    )};
+  }
+
+  auto update() noexcept -> time_point {
+    now_ = sample(mode_);
+    return now_;
+  }
+
+  [[nodiscard]] auto now() const noexcept -> time_point { return now_; }
+
+  [[nodiscard]] auto mode() const noexcept -> clock_mode { return mode_; }
+
+  void set_mode(clock_mode mode) noexcept { mode_ = mode; }
+
+private:
+  time_point now_;
+  clock_mode mode_;
+};
+
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <tio/coro/reactor.hpp>
+#include <tio/error.hpp>
+#include <tio/interest.hpp>
+#include <tio/source.hpp>
+#include <tio/token.hpp>
+
+namespace tio::coro {
+
+namespace detail {
+
+enum class direction : bool { read, write };
+
+// Operations reach their source through the readiness slot, never through
+// the `async_source` that created them, which may have moved since.
+template <typename s_t>
+[[nodiscard]] auto source_at(const io_state* st) noexcept -> s_t& {
+  return *static_cast<s_t*>(st->source);
+}
+
+// Tries `op` eagerly; on EAGAIN parks on the source's readiness slot and
+// retries from event dispatch until the result is final. One waiter per
+// direction: a second concurrent await fails with EBUSY, and destroying the
+// source while parked resumes the waiter with ECANCELED.
+template <typename op_t>
+class io_awaitable : waiter {
+public:
+  using result_type = std::invoke_result_t<op_t&>;
+
+  io_awaitable(io_state* st, direction dir, op_t op) noexcept
+    : waiter{&io_awaitable::on_ready, &io_awaitable::on_cancel}, st_{st}, dir_{dir}, op_{std::move(op)} {}
+
+  io_awaitable(const io_awaitable&) = delete;
+  auto operator=(const io_awaitable&) -> io_awaitable& = delete;
+
+  [[nodiscard]] auto await_ready() -> bool {
+    result_.emplace(op_());
+    return !is_would_block(*result_);
+  }
+
+  auto await_suspend(std::coroutine_handle<> h) noexcept -> bool {
+    if (slot() != nullptr) {
+      result_.emplace(std::unexpected{error{EBUSY}});
+      return false;
+    }
+    handle_ = h;
+    result_.reset();
+    park();
+    return true;
+  }
+
+  auto await_resume() -> result_type { return std::move(*result_); }
+
+private:
+  [[nodiscard]] static auto is_would_block(const result_type& r) noexcept -> bool {
+    return !r.has_value() && r.error().is_would_block();
+  }
+
+  [[nodiscard]] auto slot() noexcept -> waiter*& {
+    return dir_ == direction::read ? st_->reader : st_->writer;
+  }
+
+  void park() noexcept { slot() = this; }
+
+  static void on_ready(waiter* w) noexcept {
+    auto* self = static_cast<io_awaitable*>(w);
+    self->result_.emplace(self->op_());
+    if (is_would_block(*self->result_)) {
+      self->result_.reset();
+      self->park();
+      return;
+    }
+    self->handle_.resume();
+  }
+
+  static void on_cancel(waiter* w) noexcept {
+    auto* self = static_cast<io_awaitable*>(w);
+    self->result_.emplace(std::unexpected{error{ECANCELED}});
+    self->handle_.resume();
+  }
+
+  io_state* st_;
+  direction dir_;
+  op_t op_;
+  std::optional<result_type> result_;
+  std::coroutine_handle<> handle_;
+};
+
+}
+
+// Owns a source attached to a reactor. The source is registered once for
+// both directions (edge-triggered), with the address of its readiness slot
+// as token; awaiting an operation never touches epoll_ctl.
+template <typename s_t>
+  requires source<s_t>
+class async_source {
+public:
+  [[nodiscard]] static auto attach(reactor& rx, s_t s) -> result<async_source> {
+    auto st = std::make_unique<detail::io_state>();
+    const auto tok = token{reinterpret_cast<std::size_t>(st.get())};
+
+    auto reg = rx.get_registry();
+    if (auto r = reg.register_source(s, tok, interest::readable() | interest::writable());
+        !r.has_value()) {
+      return std::unexpected{r.error()};
+    }
+    return async_source{rx.core(), std::move(s), st.release()};
+  }
+
+  async_source(async_source&& other) noexcept
+    : core_{other.core_}, src_{std::move(other.src_)}, st_{std::exchange(other.st_, nullptr)} {
+    adopt();
+  }
+
+  auto operator=(async_source&& other) noexcept -> async_source& {
+    if (this != &other) {
+      release();
+      core_ = other.core_;
+      src_ = std::move(other.src_);
+      st_ = std::exchange(other.st_, nullptr);
+      adopt();
+    }
+    return *this;
+  }
+
+  async_source(const async_source&) = delete;
+  auto operator=(const async_source&) -> async_source& = delete;
+
+  ~async_source() { release(); }
+
+  [[nodiscard]] auto get() noexcept -> s_t& { return src_; }
+
+  [[nodiscard]] auto get() const noexcept -> const s_t& { return src_; }
+
+  [[nodiscard]] auto core() noexcept -> detail::reactor_core& { return *core_; }
+
+  [[nodiscard]] auto readiness() noexcept -> detail::io_state* { return st_; }
+
+  [[nodiscard]] auto async_read(std::span<std::byte> buf)
+    requires requires(const s_t& s) { s.read(buf); }
+  {
+    return make(detail::direction::read, [st = st_, buf] { return detail::source_at<s_t>(st).read(buf); });
+  }
+
+  [[nodiscard]] auto async_write(std::span<const std::byte> buf)
+    requires requires(const s_t& s) { s.write(buf); }
+  {
+    return make(detail::direction::write, [st = st_, buf] { return detail::source_at<s_t>(st).write(buf); });
+  }
+
+  [[nodiscard]] auto async_accept()
+    requires requires(const s_t& s) { s.accept(); }
+  {
+    return make(detail::direction::read, [st = st_] { return detail::source_at<s_t>(st).accept(); });
+  }
+
+  [[nodiscard]] auto async_recv_from(std::span<std::byte> buf)
+    requires requires(const s_t& s) { s.recv_from(buf); }
+  {
+    return make(detail::direction::read, [st = st_, buf] { return detail::source_at<s_t>(st).recv_from(buf); });
+  }
+
+  template <typename addr_t>
+  [[nodiscard]] auto async_send_to(std::span<const std::byte> buf, const addr_t& addr)
+    requires requires(const s_t& s) { s.send_to(buf, addr); }
+  {
+    return make(detail::direction::write, [st = st_, buf, addr] {
+      return detail::source_at<s_t>(st).send_to(buf, addr);
+    });
+  }
+
+private:
+  async_source(detail::reactor_core& core, s_t s, detail::io_state* st) noexcept
+    : core_{&core}, src_{std::move(s)}, st_{st} {
+    adopt();
+  }
+
+  void adopt() noexcept {
+    if (st_ != nullptr) {
+      st_->source = &src_;
+    }
+  }
+
+  template <typename op_t>
+  [[nodiscard]] auto make(detail::direction dir, op_t op) -> detail::io_awaitable<op_t> {
+    return detail::io_awaitable<op_t>{st_, dir, std::move(op)};
+  }
+
+  void release() noexcept {
+    if (st_ == nullptr) {
+      return;
+    }
+    [[maybe_unused]] auto r = core_->poll.get_registry().deregister_source(src_);
+    st_->source = nullptr;
+    core_->retire(std::exchange(st_, nullptr));
+  }
+
+  detail::reactor_core* core_;
+  s_t src_;
+  detail::io_state* st_;
+};
+
+}
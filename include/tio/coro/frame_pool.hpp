@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace tio::coro::detail {
+
+// Size-class free lists for coroutine frames. One pool per thread, which
+// with the one-reactor-per-thread model makes it a per-reactor pool: after
+// warm-up, frames for repeated operations are recycled without touching
+// the global allocator. Frames above the largest class go to operator new.
+class frame_pool {
+public:
+  static constexpr std::size_t k_min_class = 64;
+  static constexpr std::size_t k_classes = 7;
+  static constexpr std::size_t k_max_block = k_min_class << (k_classes - 1);
+
+  frame_pool() = default;
+  ~frame_pool();
+
+  frame_pool(const frame_pool&) = delete;
+  auto operator=(const frame_pool&) -> frame_pool& = delete;
+
+  [[nodiscard]] static auto local() noexcept -> frame_pool&;
+
+  [[nodiscard]] auto allocate(std::size_t size) -> void*;
+
+  void deallocate(void* p, std::size_t size) noexcept;
+
+  [[nodiscard]] auto allocated_blocks() const noexcept -> std::size_t { return allocated_; }
+
+  [[nodiscard]] auto cached_blocks() const noexcept -> std::size_t { return cached_; }
+
+private:
+  struct free_block {
+    free_block* next;
+  };
+
+  [[nodiscard]] static constexpr auto class_of(std::size_t size) noexcept -> std::size_t {
+    std::size_t cls = 0;
+    std::size_t block = k_min_class;
+    while (block < size) {
+      block <<= 1;
+      ++cls;
+    }
+    return cls;
+  }
+
+  std::array<free_block*, k_classes> free_{};
+  std::size_t allocated_ = 0;
+  std::size_t cached_ = 0;
+};
+
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <tio/clock.hpp>
+#include <tio/coro/task.hpp>
+#include <tio/error.hpp>
+#include <tio/event.hpp>
+#include <tio/poll.hpp>
+#include <tio/waker.hpp>
+
+namespace tio::coro {
+
+namespace detail {
+
+// Operation parked on a readiness slot. `complete` runs from dispatch.
+// `cancel` runs instead, on the loop thread, when the source is destroyed
+// while the operation is parked; it must finish it with ECANCELED.
+struct waiter {
+  void (*complete)(waiter* self) noexcept;
+  void (*cancel)(waiter* self) noexcept;
+  waiter* next_cancelled = nullptr;
+};
+
+// Per-attached-source readiness slot. Its address is the source's token,
+// so dispatch reaches the waiters without any lookup.
+struct io_state {
+  waiter* reader = nullptr;
+  waiter* writer = nullptr;
+  // The owning `async_source`'s source. Updated when it moves, so parked
+  // operations retry on the source wherever it now lives.
+  void* source = nullptr;
+  io_state* next_retired = nullptr;
+  bool retired = false;
+};
+
+// Work posted to the loop thread, possibly from another thread.
+struct task_node {
+  void (*run)(task_node* self) noexcept;
+  task_node* next = nullptr;
+};
+
+struct timer_node {
+  static constexpr std::size_t k_unqueued = static_cast<std::size_t>(-1);
+
+  void (*fire)(timer_node* self) noexcept;
+  loop_clock::time_point deadline{};
+  std::size_t heap_index = k_unqueued;
+};
+
+// A pending operation that can be stopped from any thread. `requested` is
+// set by the stop callback; `on_stop` runs later on the loop thread.
+struct cancel_node {
+  void (*on_stop)(cancel_node* self) noexcept;
+  cancel_node* prev = nullptr;
+  cancel_node* next = nullptr;
+  std::atomic<bool> requested{false};
+};
+
+struct reactor_core {
+  static constexpr auto k_waker_token = token{0};
+
+  reactor_core(tio::poll p, tio::waker w, std::size_t event_capacity)
+    : poll{std::move(p)}, wake{std::move(w)}, evs{event_capacity},
+      owner{std::this_thread::get_id()} {}
+
+  void retire(io_state* st) noexcept;
+  void reap() noexcept;
+  void run_cancelled() noexcept;
+  void dispatch(const event& ev) noexcept;
+
+  [[nodiscard]] auto on_loop_thread() const noexcept -> bool {
+    return owner.load(std::memory_order_relaxed) == std::this_thread::get_id();
+  }
+
+  void post(task_node* n) noexcept;
+  void run_posted() noexcept;
+
+  void add_timer(timer_node* t);
+  void remove_timer(timer_node* t) noexcept;
+  void fire_timers(loop_clock::time_point now) noexcept;
+
+  void track_cancel(cancel_node* c) noexcept;
+  void untrack_cancel(cancel_node* c) noexcept;
+  void request_cancel() noexcept;
+  void run_cancellations() noexcept;
+
+  [[nodiscard]] auto next_timeout(std::optional<std::chrono::milliseconds> timeout) const
+      -> std::optional<std::chrono::milliseconds>;
+
+  tio::poll poll;
+  tio::waker wake;
+  events evs;
+  std::atomic<std::thread::id> owner;
+  std::size_t live_tasks = 0;
+  io_state* retired = nullptr;
+  waiter* cancelled = nullptr;
+  bool dispatching = false;
+  bool stopped = false;
+
+  std::mutex posted_mu;
+  task_node* posted_head = nullptr;
+  task_node* posted_tail = nullptr;
+  std::atomic<bool> has_posted{false};
+
+  std::vector<timer_node*> timers;
+
+  cancel_node* cancellable = nullptr;
+  std::atomic<bool> cancel_pending{false};
+};
+
+struct detached {
+  struct promise_type : promise_base {
+    [[nodiscard]] static auto get_return_object() noexcept -> detached { return {}; }
+
+    [[nodiscard]] static auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+
+    [[nodiscard]] static auto final_suspend() noexcept -> std::suspend_never { return {}; }
+
+    static void return_void() noexcept {}
+  };
+};
+
+}
+
+// Single-threaded coroutine scheduler driven by `poll::do_poll`. Sources are
+// attached through `async_source`; their waiters are resumed inline while
+// the event batch is dispatched. The reactor owns its poll: registering
+// other sources on it with arbitrary tokens is not supported.
+class reactor {
+public:
+  static constexpr std::size_t k_default_event_capacity = 1024;
+
+  [[nodiscard]] static auto create(
+    std::size_t event_capacity = k_default_event_capacity,
+    const poll_options& opts = {}
+  ) -> result<reactor>;
+
+  reactor(reactor&&) noexcept = default;
+  auto operator=(reactor&&) noexcept -> reactor& = default;
+
+  reactor(const reactor&) = delete;
+  auto operator=(const reactor&) -> reactor& = delete;
+
+  // Starts `t` immediately; it runs until its first suspension point.
+  void spawn(task<void> t);
+
+  [[nodiscard]] auto run_once(std::optional<std::chrono::milliseconds> timeout) -> void_result;
+
+  // Runs until every spawned task has finished or `stop()` is called.
+  [[nodiscard]] auto run() -> void_result;
+
+  template <typename t_t>
+  [[nodiscard]] auto block_on(task<t_t> t) -> result<t_t>;
+
+  void stop() noexcept { core_->stopped = true; }
+
+  [[nodiscard]] auto live_tasks() const noexcept -> std::size_t { return core_->live_tasks; }
+
+  [[nodiscard]] auto loop_now() const noexcept -> loop_clock::time_point {
+    return core_->poll.loop_now();
+  }
+
+  [[nodiscard]] auto get_registry() -> registry { return core_->poll.get_registry(); }
+
+  [[nodiscard]] auto timer_count() const noexcept -> std::size_t { return core_->timers.size(); }
+
+  [[nodiscard]] auto core() noexcept -> detail::reactor_core& { return *core_; }
+
+private:
+  explicit reactor(std::unique_ptr<detail::reactor_core> core) noexcept : core_{std::move(core)} {}
+
+  std::unique_ptr<detail::reactor_core> core_;
+};
+
+namespace detail {
+
+inline auto run_detached(task<void> t, reactor_core* core) -> detached {
+  co_await std::move(t);
+  --core->live_tasks;
+}
+
+template <typename t_t>
+auto run_capture(task<t_t> t, std::optional<t_t>* out, reactor_core* core) -> detached {
+  out->emplace(co_await std::move(t));
+  --core->live_tasks;
+}
+
+inline auto run_capture(task<void> t, std::optional<bool>* out, reactor_core* core) -> detached {
+  co_await std::move(t);
+  out->emplace(true);
+  --core->live_tasks;
+}
+
+}
+
+template <typename t_t>
+auto reactor::block_on(task<t_t> t) -> result<t_t> {
+  using slot_t = std::conditional_t<std::is_void_v<t_t>, bool, t_t>;
+  std::optional<slot_t> out;
+
+  ++core_->live_tasks;
+  detail::run_capture(std::move(t), &out, core_.get());
+
+  while (!out.has_value()) {
+    if (auto r = run_once(std::nullopt); !r.has_value()) {
+      return std::unexpected{r.error()};
+    }
+  }
+
+  if constexpr (std::is_void_v<t_t>) {
+    return {};
+  } else {
+    return std::move(*out);
+  }
+}
+
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include <tio/coro/frame_pool.hpp>
+
+namespace tio::coro {
+
+template <typename t_t = void>
+class task;
+
+namespace detail {
+
+struct promise_base {
+  struct final_awaiter {
+    [[nodiscard]] static auto await_ready() noexcept -> bool { return false; }
+
+    template <typename promise_t>
+    [[nodiscard]] static auto await_suspend(std::coroutine_handle<promise_t> h) noexcept
+        -> std::coroutine_handle<> {
+      if (auto c = h.promise().continuation_) {
+        return c;
+      }
+      return std::noop_coroutine();
+    }
+
+    static void await_resume() noexcept {}
+  };
+
+  [[nodiscard]] static auto operator new(std::size_t size) -> void* {
+    return frame_pool::local().allocate(size);
+  }
+
+  static void operator delete(void* p, std::size_t size) noexcept {
+    frame_pool::local().deallocate(p, size);
+  }
+
+  [[nodiscard]] static auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+
+  [[nodiscard]] static auto final_suspend() noexcept -> final_awaiter { return {}; }
+
+  [[noreturn]] static void unhandled_exception() noexcept { std::terminate(); }
+
+  std::coroutine_handle<> continuation_;
+};
+
+template <typename t_t>
+struct promise final : promise_base {
+  auto get_return_object() noexcept -> task<t_t>;
+
+  template <typename u_t>
+  void return_value(u_t&& v) {
+    value_.emplace(std::forward<u_t>(v));
+  }
+
+  std::optional<t_t> value_;
+};
+
+template <>
+struct promise<void> final : promise_base {
+  auto get_return_object() noexcept -> task<void>;
+
+  static void return_void() noexcept {}
+};
+
+}
+
+// Lazily-started coroutine. Awaiting a task starts it and resumes the
+// awaiter by symmetric transfer when it finishes; nothing is queued.
+template <typename t_t>
+class [[nodiscard]] task {
+public:
+  using promise_type = detail::promise<t_t>;
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  task(task&& other) noexcept : handle_{std::exchange(other.handle_, {})} {}
+
+  auto operator=(task&& other) noexcept -> task& {
+    if (this != &other) {
+      if (handle_) {
+        handle_.destroy();
+      }
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  task(const task&) = delete;
+  auto operator=(const task&) -> task& = delete;
+
+  ~task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  [[nodiscard]] auto is_done() const noexcept -> bool { return !handle_ || handle_.done(); }
+
+  auto operator co_await() && noexcept {
+    struct awaiter {
+      handle_type h;
+
+      [[nodiscard]] auto await_ready() const noexcept -> bool { return !h || h.done(); }
+
+      auto await_suspend(std::coroutine_handle<> awaiting) noexcept -> std::coroutine_handle<> {
+        h.promise().continuation_ = awaiting;
+        return h;
+      }
+
+      auto await_resume() -> t_t {
+        if constexpr (!std::is_void_v<t_t>) {
+          return std::move(*h.promise().value_);
+        }
+      }
+    };
+    return awaiter{handle_};
+  }
+
+private:
+  friend struct detail::promise<t_t>;
+
+  explicit task(handle_type h) noexcept : handle_{h} {}
+
+  handle_type handle_;
+};
+
+namespace detail {
+
+template <typename t_t>
+auto promise<t_t>::get_return_object() noexcept -> task<t_t> {
+  return task<t_t>{std::coroutine_handle<promise<t_t>>::from_promise(*this)};
+}
+
+inline auto promise<void>::get_return_object() noexcept -> task<void> {
+  return task<void>{std::coroutine_handle<promise<void>>::from_promise(*this)};
+}
+
+}
+
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include <tio/event.hpp>
+#include <tio/token.hpp>
+
+namespace tio {
+
+namespace detail {
+
+template <typename t>
+concept dispatch_kind = std::integral<t> || std::is_enum_v<t>;
+
+// Group index of `k`; anything outside `[0, kinds_n)` lands in the last
+// group rather than indexing past the offsets table.
+template <std::size_t kinds_n, dispatch_kind kind_t>
+[[nodiscard]] constexpr auto group_of(const kind_t k) noexcept -> std::uint8_t {
+  constexpr auto last = static_cast<std::uint8_t>(kinds_n - 1);
+  if constexpr (std::is_enum_v<kind_t>) {
+    return group_of<kinds_n>(static_cast<std::underlying_type_t<kind_t>>(k));
+  } else {
+    if constexpr (std::is_signed_v<kind_t>) {
+      if (k < 0) {
+        return last;
+      }
+    }
+    return static_cast<std::uint64_t>(k) < kinds_n ? static_cast<std::uint8_t>(k) : last;
+  }
+}
+
+}
+
+// Two-phase dispatch over an `events` batch. Phase one resolves every
+// token to its state pointer; phase two runs the handlers while
+// prefetching the state `prefetch_distance` entries ahead, so the
+// per-connection cache misses overlap instead of serialising.
+//
+// Pointers are resolved for a whole chunk (up to `capacity` events) before
+// any handler in it runs, so a handler must not free or reuse another
+// connection's state: a later event in the same chunk would be handed the
+// stale pointer. Mark it closed and release it after `dispatch` returns.
+template <typename state_t>
+class batch_dispatcher {
+public:
+  static constexpr std::size_t k_default_prefetch_distance = 4;
+
+  explicit batch_dispatcher(
+    std::size_t capacity,
+    std::size_t prefetch_distance = k_default_prefetch_distance
+  )
+    : capacity_{std::max<std::size_t>(capacity, 1)},
+      states_{std::make_unique<state_t*[]>(capacity_)},
+      order_{std::make_unique<std::uint32_t[]>(capacity_)},
+      kinds_{std::make_unique<std::uint8_t[]>(capacity_)},
+      prefetch_distance_{prefetch_distance} {}
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return capacity_; }
+
+  [[nodiscard]] auto prefetch_distance() const noexcept -> std::size_t {
+    return prefetch_distance_;
+  }
+
+  template <typename resolve_fn, typename handle_fn>
+    requires std::invocable<resolve_fn&, token> &&
+             std::invocable<handle_fn&, const event&, state_t&>
+  void dispatch(const events& evs, resolve_fn&& resolve, handle_fn&& handle) {
+    for (std::size_t base = 0; base < evs.size(); base += capacity_) {
+      const auto n = resolve_chunk(evs, base, resolve);
+
+      for (std::size_t i = 0; i < n; ++i) {
+        order_[i] = static_cast<std::uint32_t>(i);
+      }
+      run_chunk(evs, base, n, handle);
+    }
+  }
+
+  // Same as `dispatch`, but within each batch events are stably grouped by
+  // the kind returned from `kind(event, state)` (an integer or enum in
+  // `[0, kinds_n)`) before handlers run, so e.g. all listener events go
+  // before stream events. Out-of-range kinds are put in the last group.
+  template <std::size_t kinds_n, typename kind_fn, typename resolve_fn, typename handle_fn>
+    requires(kinds_n > 0 && kinds_n <= 256) &&
+            std::invocable<kind_fn&, const event&, const state_t*> &&
+            detail::dispatch_kind<std::invoke_result_t<kind_fn&, const event&, const state_t*>> &&
+            std::invocable<resolve_fn&, token> &&
+            std::invocable<handle_fn&, const event&, state_t&>
+  void dispatch_grouped(const events& evs, kind_fn&& kind, resolve_fn&& resolve, handle_fn&& handle) {
+    for (std::size_t base = 0; base < evs.size(); base += capacity_) {
+      const auto n = resolve_chunk(evs, base, resolve);
+
+      std::array<std::size_t, kinds_n + 1> offsets{};
+      for (std::size_t i = 0; i < n; ++i) {
+        const auto k = detail::group_of<kinds_n>(kind(evs[base + i], states_[i]));
+        kinds_[i] = k;
+        ++offsets[k + 1];
+      }
+      for (std::size_t k = 0; k < kinds_n; ++k) {
+        offsets[k + 1] += offsets[k];
+      }
+      for (std::size_t i = 0; i < n; ++i) {
+        order_[offsets[kinds_[i]]++] = static_cast<std::uint32_t>(i);
+      }
+      run_chunk(evs, base, n, handle);
+    }
+  }
+
+private:
+  template <typename resolve_fn>
+  [[nodiscard]] auto resolve_chunk(const events& evs, std::size_t base, resolve_fn& resolve)
+      -> std::size_t {
+    const auto left = evs.size() - base;
+    const auto n = left < capacity_ ? left : capacity_;
+
+    for (std::size_t i = 0; i < n; ++i) {
+      states_[i] = resolve(evs[base + i].tok());
+    }
+    return n;
+  }
+
+  template <typename handle_fn>
+  void run_chunk(const events& evs, std::size_t base, std::size_t n, handle_fn& handle) {
+    for (std::size_t i = 0; i < n && i < prefetch_distance_; ++i) {
+      prefetch(states_[order_[i]]);
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+      if (i + prefetch_distance_ < n) {
+        prefetch(states_[order_[i + prefetch_distance_]]);
+      }
+      const auto idx = order_[i];
+      if (state_t* st = states_[idx]; st != nullptr) {
+        handle(evs[base + idx], *st);
+      }
+    }
+  }
+
+  static void prefetch(const state_t* st) noexcept {
+    if (st != nullptr) {
+      __builtin_prefetch(st, 1, 3);
+    }
+  }
+
+  std::size_t capacity_;
+  std::unique_ptr<state_t*[]> states_;
+  std::unique_ptr<std::uint32_t[]> order_;
+  std::unique_ptr<std::uint8_t[]> kinds_;
+  std::size_t prefetch_distance_;
+};
+
+}
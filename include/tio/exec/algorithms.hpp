@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+
+#include <tio/coro/reactor.hpp>
+#include <tio/error.hpp>
+#include <tio/exec/sender.hpp>
+
+namespace tio::exec {
+
+namespace detail {
+
+template <typename fn_t, typename v_t>
+struct then_result {
+  using type = std::invoke_result_t<fn_t&, v_t>;
+};
+
+template <typename fn_t>
+struct then_result<fn_t, void> {
+  using type = std::invoke_result_t<fn_t&>;
+};
+
+template <typename fn_t, typename r_t>
+class then_receiver {
+public:
+  then_receiver(fn_t fn, r_t r) noexcept : fn_{std::move(fn)}, r_{std::move(r)} {}
+
+  template <typename... args_t>
+  void set_value(args_t&&... args) noexcept {
+    if constexpr (std::is_void_v<std::invoke_result_t<fn_t&, args_t...>>) {
+      std::invoke(fn_, std::forward<args_t>(args)...);
+      r_.set_value();
+    } else {
+      r_.set_value(std::invoke(fn_, std::forward<args_t>(args)...));
+    }
+  }
+
+  void set_error(const error& e) noexcept { r_.set_error(e); }
+
+  void set_stopped() noexcept { r_.set_stopped(); }
+
+  [[nodiscard]] auto get_env() const noexcept -> env { return exec::get_env(r_); }
+
+private:
+  fn_t fn_;
+  r_t r_;
+};
+
+template <typename fn_t>
+struct then_closure {
+  fn_t fn;
+};
+
+}
+
+// Runs `fn` on the value of `s`, inline on whichever thread completes `s`.
+// Errors and stops pass through untouched.
+template <sender s_t, typename fn_t>
+class then_sender {
+public:
+  using sender_concept = sender_tag;
+  using value_type = typename detail::then_result<fn_t, value_type_of<s_t>>::type;
+
+  then_sender(s_t s, fn_t fn) noexcept : s_{std::move(s)}, fn_{std::move(fn)} {}
+
+  template <typename r_t>
+  [[nodiscard]] auto connect(r_t r) && {
+    return std::move(s_).connect(detail::then_receiver<fn_t, r_t>{std::move(fn_), std::move(r)});
+  }
+
+private:
+  s_t s_;
+  fn_t fn_;
+};
+
+template <sender s_t, typename fn_t>
+[[nodiscard]] auto then(s_t s, fn_t fn) -> then_sender<s_t, fn_t> {
+  return then_sender<s_t, fn_t>{std::move(s), std::move(fn)};
+}
+
+template <typename fn_t>
+[[nodiscard]] auto then(fn_t fn) -> detail::then_closure<fn_t> {
+  return {std::move(fn)};
+}
+
+template <sender s_t, typename fn_t>
+[[nodiscard]] auto operator|(s_t s, detail::then_closure<fn_t> c) -> then_sender<s_t, fn_t> {
+  return then(std::move(s), std::move(c.fn));
+}
+
+namespace detail {
+
+template <typename v_t>
+struct sync_wait_state {
+  std::optional<result<v_t>> out;
+  bool done = false;
+};
+
+template <typename v_t>
+class sync_wait_receiver {
+public:
+  sync_wait_receiver(sync_wait_state<v_t>* st, std::stop_token stop) noexcept
+    : st_{st}, stop_{std::move(stop)} {}
+
+  template <typename... args_t>
+  void set_value(args_t&&... args) noexcept {
+    st_->out.emplace(std::in_place, std::forward<args_t>(args)...);
+    st_->done = true;
+  }
+
+  void set_error(const error& e) noexcept {
+    st_->out.emplace(std::unexpected{e});
+    st_->done = true;
+  }
+
+  void set_stopped() noexcept { st_->done = true; }
+
+  [[nodiscard]] auto get_env() const noexcept -> env { return env{stop_}; }
+
+private:
+  sync_wait_state<v_t>* st_;
+  std::stop_token stop_;
+};
+
+}
+
+// Starts `s` and drives `rx` on the calling thread until it completes.
+// Returns nullopt if the operation was stopped; a reactor failure is
+// reported as the operation's error.
+template <sender s_t>
+[[nodiscard]] auto sync_wait(coro::reactor& rx, s_t s, std::stop_token stop = {})
+    -> std::optional<result<value_type_of<s_t>>> {
+  using value_t = value_type_of<s_t>;
+
+  detail::sync_wait_state<value_t> st;
+  auto op = std::move(s).connect(detail::sync_wait_receiver<value_t>{&st, std::move(stop)});
+  op.start();
+
+  while (!st.done) {
+    if (auto r = rx.run_once(std::nullopt); !r.has_value()) {
+      return result<value_t>{std::unexpected{r.error()}};
+    }
+  }
+  return std::move(st.out);
+}
+
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <tio/coro/async_source.hpp>
+#include <tio/coro/reactor.hpp>
+#include <tio/error.hpp>
+#include <tio/exec/sender.hpp>
+
+namespace tio::exec {
+
+namespace detail {
+
+using coro::detail::direction;
+
+// Tries the operation once when started and otherwise parks on the
+// source's readiness slot, exactly like the coroutine awaitable.
+template <typename op_t, typename r_t>
+class io_op : task_node, waiter, cancel_node {
+public:
+  using result_type = std::invoke_result_t<op_t&>;
+
+  io_op(reactor_core* core, io_state* st, direction dir, op_t op, r_t r) noexcept
+    : task_node{&io_op::arm_posted}, waiter{&io_op::on_ready, &io_op::on_cancel}, cancel_node{&io_op::on_stop},
+      core_{core}, st_{st}, dir_{dir}, op_{std::move(op)}, r_{std::move(r)} {}
+
+  io_op(const io_op&) = delete;
+  auto operator=(const io_op&) -> io_op& = delete;
+
+  void start() noexcept {
+    if (core_->on_loop_thread()) {
+      arm();
+    } else {
+      core_->post(this);
+    }
+  }
+
+private:
+  [[nodiscard]] static auto is_would_block(const result_type& r) noexcept -> bool {
+    return !r.has_value() && r.error().is_would_block();
+  }
+
+  [[nodiscard]] auto slot() noexcept -> waiter*& {
+    return dir_ == direction::read ? st_->reader : st_->writer;
+  }
+
+  void arm() noexcept {
+    const auto stop = get_stop_token(r_);
+    if (stop.stop_requested()) {
+      r_.set_stopped();
+      return;
+    }
+
+    auto res = op_();
+    if (!is_would_block(res)) {
+      deliver(r_, std::move(res));
+      return;
+    }
+
+    if (slot() != nullptr) {
+      deliver(r_, result_type{std::unexpected{error{EBUSY}}});
+      return;
+    }
+
+    slot() = this;
+    if (stop.stop_possible()) {
+      core_->track_cancel(this);
+      on_stop_.emplace(stop, stop_request{this, core_});
+    }
+  }
+
+  static void arm_posted(task_node* n) noexcept { static_cast<io_op*>(n)->arm(); }
+
+  static void on_ready(waiter* w) noexcept {
+    auto* self = static_cast<io_op*>(w);
+    auto res = self->op_();
+    if (is_would_block(res)) {
+      self->slot() = self;
+      return;
+    }
+
+    if (self->on_stop_.has_value()) {
+      self->core_->untrack_cancel(self);
+      self->on_stop_.reset();
+    }
+    deliver(self->r_, std::move(res));
+  }
+
+  // The source was destroyed while parked; its slot is already gone.
+  static void on_cancel(waiter* w) noexcept {
+    auto* self = static_cast<io_op*>(w);
+    if (self->on_stop_.has_value()) {
+      self->core_->untrack_cancel(self);
+      self->on_stop_.reset();
+    }
+    deliver(self->r_, result_type{std::unexpected{error{ECANCELED}}});
+  }
+
+  static void on_stop(cancel_node* c) noexcept {
+    auto* self = static_cast<io_op*>(c);
+    if (self->slot() == static_cast<waiter*>(self)) {
+      self->slot() = nullptr;
+    }
+    self->on_stop_.reset();
+    self->r_.set_stopped();
+  }
+
+  reactor_core* core_;
+  io_state* st_;
+  direction dir_;
+  op_t op_;
+  r_t r_;
+  stop_callback on_stop_;
+};
+
+template <typename op_t>
+class io_sender {
+public:
+  using sender_concept = sender_tag;
+  using value_type = typename std::invoke_result_t<op_t&>::value_type;
+
+  io_sender(reactor_core* core, io_state* st, direction dir, op_t op) noexcept
+    : core_{core}, st_{st}, dir_{dir}, op_{std::move(op)} {}
+
+  template <typename r_t>
+  [[nodiscard]] auto connect(r_t r) && -> io_op<op_t, r_t> {
+    return io_op<op_t, r_t>{core_, st_, dir_, std::move(op_), std::move(r)};
+  }
+
+private:
+  reactor_core* core_;
+  io_state* st_;
+  direction dir_;
+  op_t op_;
+};
+
+template <typename s_t, typename op_t>
+[[nodiscard]] auto make_io(coro::async_source<s_t>& src, direction dir, op_t op)
+    -> io_sender<op_t> {
+  return io_sender<op_t>{&src.core(), src.readiness(), dir, std::move(op)};
+}
+
+}
+
+// I/O senders over a source attached to a reactor. The source and buffer
+// must outlive the operation, though the `async_source` may be moved while
+// it is pending; operations must be started on, or are forwarded to, the
+// reactor's loop thread.
+template <typename s_t>
+[[nodiscard]] auto async_read(coro::async_source<s_t>& src, std::span<std::byte> buf)
+  requires requires(const s_t& s) { s.read(buf); }
+{
+  return detail::make_io(src, detail::direction::read, [st = src.readiness(), buf] {
+    return coro::detail::source_at<s_t>(st).read(buf);
+  });
+}
+
+template <typename s_t>
+[[nodiscard]] auto async_write(coro::async_source<s_t>& src, std::span<const std::byte> buf)
+  requires requires(const s_t& s) { s.write(buf); }
+{
+  return detail::make_io(src, detail::direction::write, [st = src.readiness(), buf] {
+    return coro::detail::source_at<s_t>(st).write(buf);
+  });
+}
+
+template <typename s_t>
+[[nodiscard]] auto async_accept(coro::async_source<s_t>& src)
+  requires requires(const s_t& s) { s.accept(); }
+{
+  return detail::make_io(src, detail::direction::read, [st = src.readiness()] {
+    return coro::detail::source_at<s_t>(st).accept();
+  });
+}
+
+}
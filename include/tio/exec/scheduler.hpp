@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <utility>
+
+#include <tio/clock.hpp>
+#include <tio/coro/reactor.hpp>
+#include <tio/exec/sender.hpp>
+
+namespace tio::exec {
+
+namespace detail {
+
+template <typename r_t>
+class schedule_op : task_node {
+public:
+  schedule_op(reactor_core* core, r_t r) noexcept
+    : task_node{&schedule_op::run}, core_{core}, r_{std::move(r)} {}
+
+  schedule_op(const schedule_op&) = delete;
+  auto operator=(const schedule_op&) -> schedule_op& = delete;
+
+  void start() noexcept { core_->post(this); }
+
+private:
+  static void run(task_node* n) noexcept {
+    auto* self = static_cast<schedule_op*>(n);
+    if (get_stop_token(self->r_).stop_requested()) {
+      self->r_.set_stopped();
+    } else {
+      self->r_.set_value();
+    }
+  }
+
+  reactor_core* core_;
+  r_t r_;
+};
+
+// Timers live in the reactor's heap, which is only touched on the loop
+// thread; starting from another thread posts the arming step first.
+template <typename r_t>
+class timer_op : task_node, timer_node, cancel_node {
+public:
+  timer_op(reactor_core* core, loop_clock::duration after, r_t r) noexcept
+    : task_node{&timer_op::arm_posted}, timer_node{&timer_op::on_fire},
+      cancel_node{&timer_op::on_stop}, core_{core}, after_{after}, r_{std::move(r)} {}
+
+  timer_op(const timer_op&) = delete;
+  auto operator=(const timer_op&) -> timer_op& = delete;
+
+  void start() noexcept {
+    if (core_->on_loop_thread()) {
+      arm();
+    } else {
+      core_->post(this);
+    }
+  }
+
+private:
+  void arm() noexcept {
+    const auto stop = get_stop_token(r_);
+    if (stop.stop_requested()) {
+      r_.set_stopped();
+      return;
+    }
+
+    deadline = loop_clock::sample(core_->poll.clock().mode()) + after_;
+    core_->add_timer(this);
+    if (stop.stop_possible()) {
+      core_->track_cancel(this);
+      on_stop_.emplace(stop, stop_request{this, core_});
+    }
+  }
+
+  static void arm_posted(task_node* n) noexcept { static_cast<timer_op*>(n)->arm(); }
+
+  static void on_fire(timer_node* t) noexcept {
+    auto* self = static_cast<timer_op*>(t);
+    if (self->on_stop_.has_value()) {
+      self->core_->untrack_cancel(self);
+      self->on_stop_.reset();
+    }
+    self->r_.set_value();
+  }
+
+  static void on_stop(cancel_node* c) noexcept {
+    auto* self = static_cast<timer_op*>(c);
+    self->core_->remove_timer(self);
+    self->on_stop_.reset();
+    self->r_.set_stopped();
+  }
+
+  reactor_core* core_;
+  loop_clock::duration after_;
+  r_t r_;
+  stop_callback on_stop_;
+};
+
+}
+
+class scheduler;
+
+class schedule_sender {
+public:
+  using sender_concept = sender_tag;
+  using value_type = void;
+
+  template <typename r_t>
+  [[nodiscard]] auto connect(r_t r) && -> detail::schedule_op<r_t> {
+    return detail::schedule_op<r_t>{core_, std::move(r)};
+  }
+
+private:
+  friend class scheduler;
+
+  explicit schedule_sender(coro::detail::reactor_core* core) noexcept : core_{core} {}
+
+  coro::detail::reactor_core* core_;
+};
+
+class timer_sender {
+public:
+  using sender_concept = sender_tag;
+  using value_type = void;
+
+  template <typename r_t>
+  [[nodiscard]] auto connect(r_t r) && -> detail::timer_op<r_t> {
+    return detail::timer_op<r_t>{core_, after_, std::move(r)};
+  }
+
+private:
+  friend class scheduler;
+
+  timer_sender(coro::detail::reactor_core* core, loop_clock::duration after) noexcept
+    : core_{core}, after_{after} {}
+
+  coro::detail::reactor_core* core_;
+  loop_clock::duration after_;
+};
+
+// Handle to a reactor's loop thread. `schedule()` may be started from any
+// thread and completes on the loop; `schedule_after()` completes once the
+// loop clock has passed the delay. Both honour the receiver's stop token.
+class scheduler {
+public:
+  explicit scheduler(coro::reactor& rx) noexcept : core_{&rx.core()} {}
+
+  [[nodiscard]] auto schedule() const noexcept -> schedule_sender {
+    return schedule_sender{core_};
+  }
+
+  template <typename rep_t, typename period_t>
+  [[nodiscard]] auto schedule_after(std::chrono::duration<rep_t, period_t> after) const noexcept
+      -> timer_sender {
+    return timer_sender{core_, std::chrono::ceil<loop_clock::duration>(after)};
+  }
+
+  [[nodiscard]] auto now() const noexcept -> loop_clock::time_point {
+    return core_->poll.loop_now();
+  }
+
+  [[nodiscard]] auto operator==(const scheduler&) const noexcept -> bool = default;
+
+private:
+  coro::detail::reactor_core* core_;
+};
+
+}
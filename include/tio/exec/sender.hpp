@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <optional>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+
+#include <tio/coro/reactor.hpp>
+#include <tio/error.hpp>
+
+// Sender/receiver protocol in the shape of P2300, expressed with member
+// functions so it works without a standard library that ships
+// std::execution:
+//
+//  - a sender has `sender_concept = sender_tag`, a single `value_type`
+//    (possibly void) and `connect(receiver) &&` returning an operation state;
+//  - an operation state is immovable and has `start() noexcept`;
+//  - a receiver has `set_value(value_type)`, `set_error(tio::error)` and
+//    `set_stopped()`, all noexcept, and optionally `get_env() -> env`.
+//
+// Exactly one completion is delivered per started operation.
+namespace tio::exec {
+
+struct sender_tag {};
+
+struct env {
+  std::stop_token stop_token;
+};
+
+template <typename s_t>
+concept sender = std::same_as<typename std::remove_cvref_t<s_t>::sender_concept, sender_tag> &&
+                 requires { typename std::remove_cvref_t<s_t>::value_type; };
+
+template <typename s_t>
+using value_type_of = typename std::remove_cvref_t<s_t>::value_type;
+
+template <typename r_t>
+[[nodiscard]] auto get_stop_token(const r_t& r) noexcept -> std::stop_token {
+  if constexpr (requires { r.get_env(); }) {
+    return r.get_env().stop_token;
+  } else {
+    return {};
+  }
+}
+
+template <typename r_t>
+[[nodiscard]] auto get_env(const r_t& r) noexcept -> env {
+  return env{get_stop_token(r)};
+}
+
+namespace detail {
+
+using coro::detail::cancel_node;
+using coro::detail::io_state;
+using coro::detail::reactor_core;
+using coro::detail::task_node;
+using coro::detail::timer_node;
+using coro::detail::waiter;
+
+// Completes `r` with the outcome of a tio operation.
+template <typename r_t, typename v_t>
+void deliver(r_t& r, result<v_t>&& res) noexcept {
+  if (!res.has_value()) {
+    r.set_error(res.error());
+  } else if constexpr (std::is_void_v<v_t>) {
+    r.set_value();
+  } else {
+    r.set_value(std::move(*res));
+  }
+}
+
+// Stop callback for operations parked on the reactor. It only flags the
+// node; the reactor unlinks it and calls `on_stop` on the loop thread.
+struct stop_request {
+  cancel_node* node;
+  reactor_core* core;
+
+  void operator()() const noexcept {
+    node->requested.store(true, std::memory_order_release);
+    core->request_cancel();
+  }
+};
+
+using stop_callback = std::optional<std::stop_callback<stop_request>>;
+
+}
+
+}
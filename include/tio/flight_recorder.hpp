@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include <unistd.h>
+
+#include <tio/clock.hpp>
+#include <tio/token.hpp>
+
+namespace tio {
+
+namespace detail {
+
+inline auto current_thread_id() noexcept -> std::uint32_t {
+  static thread_local const auto tid = static_cast<std::uint32_t>(::gettid());
+  return tid;
+}
+
+}
+
+enum class flight_event : std::uint8_t {
+  poll_wait,      // arg = events returned
+  dispatch,       // id = token
+  register_fd,    // id = token, arg = fd
+  reregister_fd,  // id = token, arg = fd
+  deregister_fd,  // arg = fd
+  wake,           // id = waker token
+};
+
+struct flight_record {
+  flight_event kind = flight_event::poll_wait;
+  std::uint8_t interest_bits = 0;
+  std::uint16_t err = 0;
+  std::uint32_t thread = 0;
+  loop_clock::time_point start{};
+  std::chrono::nanoseconds duration{0};
+  std::uint64_t id = 0;
+  std::uint64_t arg = 0;
+};
+
+// Fixed ring of the last `capacity()` loop events. Writers on any thread
+// claim a slot with one fetch_add and publish it under a per-slot sequence
+// number, so recording never blocks or allocates and a reader can copy the
+// ring while writers keep going; slots overwritten mid-copy are skipped.
+class flight_recorder {
+public:
+  // `capacity` is rounded up to a power of two.
+  explicit flight_recorder(std::size_t capacity, clock_mode mode = clock_mode::precise)
+    : mask_{std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1},
+      slots_{std::make_unique<slot[]>(mask_ + 1)}, mode_{mode} {}
+
+  flight_recorder(const flight_recorder&) = delete;
+  auto operator=(const flight_recorder&) -> flight_recorder& = delete;
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return mask_ + 1; }
+
+  [[nodiscard]] auto now() const noexcept -> loop_clock::time_point { return loop_clock::sample(mode_); }
+
+  void record(
+    flight_event kind,
+    loop_clock::time_point start,
+    loop_clock::duration duration,
+    std::uint64_t id,
+    std::uint64_t arg,
+    std::uint8_t interest_bits = 0,
+    int err = 0
+  ) noexcept {
+    constexpr auto r = std::memory_order_relaxed;
+    const auto n = head_.fetch_add(1, r);
+    auto& s = slots_[n & mask_];
+    s.seq.store(2 * n + 1, r);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.start.store(start.time_since_epoch().count(), r);
+    s.duration.store(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(), r);
+    s.id.store(id, r);
+    s.arg.store(arg, r);
+    s.meta.store(
+      static_cast<std::uint64_t>(kind) | static_cast<std::uint64_t>(interest_bits) << 8
+        | static_cast<std::uint64_t>(static_cast<std::uint16_t>(err)) << 16
+        | static_cast<std::uint64_t>(detail::current_thread_id()) << 32,
+      r
+    );
+    s.seq.store(2 * n + 2, std::memory_order_release);
+  }
+
+  // Total records ever written; those older than `capacity()` are gone.
+  [[nodiscard]] auto recorded() const noexcept -> std::uint64_t { return head_.load(std::memory_order_relaxed); }
+
+  // Oldest first.
+  [[nodiscard]] auto snapshot() const -> std::vector<flight_record>;
+
+  // Chrome trace event JSON, loadable by chrome://tracing and Perfetto.
+  // Waits and dispatches become complete ("X") slices, the rest instants.
+  void write_chrome_trace(std::ostream& out) const;
+
+private:
+  struct alignas(64) slot {
+    std::atomic<std::uint64_t> seq{0};
+    std::atomic<std::int64_t> start{0};
+    std::atomic<std::int64_t> duration{0};
+    std::atomic<std::uint64_t> id{0};
+    std::atomic<std::uint64_t> arg{0};
+    std::atomic<std::uint64_t> meta{0};
+  };
+
+  std::size_t mask_;
+  std::unique_ptr<slot[]> slots_;
+  clock_mode mode_;
+  alignas(64) std::atomic<std::uint64_t> head_{0};
+};
+
+// Records one `dispatch` slice for `tok` covering this scope. A null
+// recorder makes it a no-op, so handlers can use it unconditionally:
+//
+//   const flight_scope scope{p.recorder(), ev.tok()};
+class flight_scope {
+public:
+  flight_scope(flight_recorder* rec, token tok) noexcept
+    : rec_{rec}, tok_{tok}, start_{rec != nullptr ? rec->now() : loop_clock::time_point{}} {}
+
+  ~flight_scope() {
+    if (rec_ != nullptr) {
+      rec_->record(flight_event::dispatch, start_, rec_->now() - start_, tok_.value(), 0);
+    }
+  }
+
+  flight_scope(const flight_scope&) = delete;
+  auto operator=(const flight_scope&) -> flight_scope& = delete;
+
+private:
+  flight_recorder* rec_;
+  token tok_;
+  loop_clock::time_point start_;
+};
+
+}
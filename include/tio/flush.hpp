@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <tio/error.hpp>
+
+namespace tio {
+
+class flush_queue;
+
+// Pending output for one fd. Handlers append while dispatching; the bytes
+// leave in the flush phase, so several responses to pipelined requests go
+// out in one gathered write. Segment order is preserved.
+class outbox {
+public:
+  explicit outbox(int fd) noexcept : fd_{fd} {}
+
+  outbox(const outbox&) = delete;
+  auto operator=(const outbox&) -> outbox& = delete;
+
+  ~outbox();
+
+  // Copies `bytes` into the outbox.
+  void append(std::span<const std::byte> bytes);
+
+  // Queues `bytes` without copying; they must stay valid until flushed.
+  void append_ref(std::span<const std::byte> bytes);
+
+  // Writes as much as the fd accepts in one gathered syscall. Returns the
+  // bytes written; EAGAIN leaves the remainder queued.
+  [[nodiscard]] auto write_some(std::size_t max_bytes = std::numeric_limits<std::size_t>::max())
+      -> result<std::size_t>;
+
+  [[nodiscard]] auto pending_bytes() const noexcept -> std::size_t { return pending_; }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return pending_ == 0; }
+
+  [[nodiscard]] auto is_queued() const noexcept -> bool { return queue_ != nullptr; }
+
+  // Last non-EAGAIN error seen by the flush phase, if any.
+  [[nodiscard]] auto last_error() const noexcept -> std::optional<error> { return error_; }
+
+  [[nodiscard]] auto fd() const noexcept -> int { return fd_; }
+
+  // Bytes held by the copy arena, written or not; bounded by roughly twice
+  // the pending copied bytes plus the compaction threshold.
+  [[nodiscard]] auto arena_bytes() const noexcept -> std::size_t { return arena_.size(); }
+
+private:
+  friend class flush_queue;
+
+  struct segment {
+    const std::byte* ref;  // nullptr: bytes live in `arena_` at `off`
+    std::size_t off;
+    std::size_t len;
+  };
+
+  void consume(std::size_t n) noexcept;
+  void compact() noexcept;
+
+  int fd_;
+  std::vector<segment> segs_;
+  std::size_t first_ = 0;
+  std::vector<std::byte> arena_;
+  std::size_t pending_ = 0;
+  std::optional<error> error_;
+  bool is_socket_ = true;
+
+  flush_queue* queue_ = nullptr;
+  outbox* prev_ = nullptr;
+  outbox* next_ = nullptr;
+};
+
+struct flush_stats {
+  std::uint64_t syscalls = 0;
+  std::uint64_t bytes = 0;
+  std::uint64_t would_block = 0;
+  std::uint64_t errors = 0;
+
+  [[nodiscard]] auto bytes_per_syscall() const noexcept -> double {
+    return syscalls == 0 ? 0.0 : static_cast<double>(bytes) / static_cast<double>(syscalls);
+  }
+};
+
+// Deferred write phase. Handlers `mark` outboxes during dispatch; `flush`
+// runs once after the event batch and writes each marked outbox with one
+// gathered syscall, in marking order. An outbox that still has more than
+// `fair_share` bytes after its turn goes to the back for the next flush.
+class flush_queue {
+public:
+  explicit flush_queue(std::size_t fair_share = std::numeric_limits<std::size_t>::max()) noexcept
+    : fair_share_{fair_share} {}
+
+  flush_queue(const flush_queue&) = delete;
+  auto operator=(const flush_queue&) -> flush_queue& = delete;
+
+  ~flush_queue();
+
+  // Idempotent: an outbox is queued at most once.
+  void mark(outbox& o) noexcept;
+
+  void unmark(outbox& o) noexcept;
+
+  // Returns how many outboxes were written to. Outboxes that hit EAGAIN or
+  // an error leave the queue; re-mark them on the next writable event.
+  auto flush() -> std::size_t;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+
+  [[nodiscard]] auto stats() const noexcept -> const flush_stats& { return stats_; }
+
+  void reset_stats() noexcept { stats_ = {}; }
+
+private:
+  void push_back(outbox& o) noexcept;
+
+  outbox* head_ = nullptr;
+  outbox* tail_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t fair_share_;
+  flush_stats stats_;
+};
+
+}
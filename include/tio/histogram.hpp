@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tio {
+
+// Bucket layout shared by `latency_histogram` and `histogram_snapshot`:
+// values below 64 get one bucket each, every power of two above is split
+// into 64 linear sub-buckets (at most 1/64 relative error, like an HDR
+// histogram with ~2 significant digits). Values are nanoseconds and clamp
+// at 2^40 (~18 minutes).
+struct histogram_layout {
+  static constexpr unsigned k_sub_bits = 6;
+  static constexpr unsigned k_max_bits = 40;
+  static constexpr std::uint64_t k_sub = 1ULL << k_sub_bits;
+  static constexpr std::uint64_t k_max_value = (1ULL << k_max_bits) - 1;
+  static constexpr std::size_t k_buckets = (k_max_bits - k_sub_bits + 1) * k_sub;
+
+  [[nodiscard]] static constexpr auto index(std::uint64_t v) noexcept -> std::size_t {
+    v = std::min(v, k_max_value);
+    if (v < k_sub) {
+      return static_cast<std::size_t>(v);
+    }
+    const auto mag = static_cast<unsigned>(std::bit_width(v)) - 1;
+    const auto sub = (v >> (mag - k_sub_bits)) & (k_sub - 1);
+    return static_cast<std::size_t>((mag - k_sub_bits + 1) * k_sub + sub);
+  }
+
+  [[nodiscard]] static constexpr auto lower(std::size_t i) noexcept -> std::uint64_t {
+    if (i < k_sub) {
+      return i;
+    }
+    const auto mag = i / k_sub + k_sub_bits - 1;
+    return (k_sub + i % k_sub) << (mag - k_sub_bits);
+  }
+
+  [[nodiscard]] static constexpr auto upper(std::size_t i) noexcept -> std::uint64_t {
+    if (i < k_sub) {
+      return i;
+    }
+    const auto mag = i / k_sub + k_sub_bits - 1;
+    return lower(i) + (1ULL << (mag - k_sub_bits)) - 1;
+  }
+};
+
+// Plain copy of a histogram. Snapshots from different threads or polls
+// merge by adding counts; percentiles report the upper bound of the bucket
+// holding the requested rank, capped at the recorded maximum.
+class histogram_snapshot {
+public:
+  histogram_snapshot() : counts_(histogram_layout::k_buckets) {}
+
+  void merge(const histogram_snapshot& o) noexcept {
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+      counts_[i] += o.counts_[i];
+    }
+    total_ += o.total_;
+    sum_ += o.sum_;
+    max_ = std::max(max_, o.max_);
+  }
+
+  // `q` in [0, 100].
+  [[nodiscard]] auto percentile(double q) const noexcept -> std::chrono::nanoseconds {
+    if (total_ == 0) {
+      return std::chrono::nanoseconds{0};
+    }
+    const auto want = static_cast<std::uint64_t>(std::clamp(q, 0.0, 100.0) / 100.0 * static_cast<double>(total_ - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+      seen += counts_[i];
+      if (seen >= want) {
+        return as_ns(std::min(histogram_layout::upper(i), max_));
+      }
+    }
+    return as_ns(max_);
+  }
+
+  [[nodiscard]] auto count() const noexcept -> std::uint64_t { return total_; }
+
+  [[nodiscard]] auto max() const noexcept -> std::chrono::nanoseconds { return as_ns(max_); }
+
+  [[nodiscard]] auto mean() const noexcept -> std::chrono::nanoseconds {
+    return as_ns(total_ == 0 ? 0 : sum_ / total_);
+  }
+
+  // Calls `fn(lower, upper, count)` for every non-empty bucket, in order.
+  template <typename fn_t>
+  void for_each_bucket(fn_t&& fn) const {
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+      if (counts_[i] != 0) {
+        fn(as_ns(histogram_layout::lower(i)), as_ns(histogram_layout::upper(i)), counts_[i]);
+      }
+    }
+  }
+
+private:
+  friend class latency_histogram;
+
+  static auto as_ns(std::uint64_t v) noexcept -> std::chrono::nanoseconds {
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(v)};
+  }
+
+  std::vector<std::uint64_t> counts_;
+  std::uint64_t total_ = 0;
+  std::uint64_t sum_ = 0;
+  std::uint64_t max_ = 0;
+};
+
+// Fixed-size latency histogram. `record` is a handful of relaxed atomic
+// adds into preallocated buckets: no allocation, no lock, safe from any
+// number of threads. Reading takes a `snapshot()`, which is not one
+// consistent cut while writers are active.
+class latency_histogram {
+public:
+  latency_histogram() noexcept = default;
+
+  latency_histogram(const latency_histogram&) = delete;
+  auto operator=(const latency_histogram&) -> latency_histogram& = delete;
+
+  void record(std::uint64_t ns) noexcept {
+    constexpr auto r = std::memory_order_relaxed;
+    counts_[histogram_layout::index(ns)].fetch_add(1, r);
+    total_.fetch_add(1, r);
+    sum_.fetch_add(ns, r);
+    auto m = max_.load(r);
+    while (ns > m && !max_.compare_exchange_weak(m, ns, r)) {
+    }
+  }
+
+  // Negative durations record as zero.
+  void record(std::chrono::nanoseconds d) noexcept {
+    record(d.count() > 0 ? static_cast<std::uint64_t>(d.count()) : 0);
+  }
+
+  [[nodiscard]] auto snapshot() const -> histogram_snapshot {
+    constexpr auto r = std::memory_order_relaxed;
+    histogram_snapshot s;
+    for (std::size_t i = 0; i < counts_.size(); ++i) {
+      s.counts_[i] = counts_[i].load(r);
+    }
+    s.total_ = total_.load(r);
+    s.sum_ = sum_.load(r);
+    s.max_ = max_.load(r);
+    return s;
+  }
+
+  [[nodiscard]] auto count() const noexcept -> std::uint64_t { return total_.load(std::memory_order_relaxed); }
+
+  // Not atomic with respect to concurrent `record` calls.
+  void reset() noexcept {
+    constexpr auto r = std::memory_order_relaxed;
+    for (auto& c : counts_) {
+      c.store(0, r);
+    }
+    total_.store(0, r);
+    sum_.store(0, r);
+    max_.store(0, r);
+  }
+
+private:
+  std::array<std::atomic<std::uint64_t>, histogram_layout::k_buckets> counts_{};
+  std::atomic<std::uint64_t> total_{0};
+  std::atomic<std::uint64_t> sum_{0};
+  std::atomic<std::uint64_t> max_{0};
+};
+
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <sys/uio.h>
+
+#include <tio/error.hpp>
+#include <tio/event.hpp>
+
+namespace tio {
+
+// I/O accounting for one connection, small enough to keep in every slot of
+// a connection slab. Pass it to the counting `read` / `write` overloads of
+// `tcp_stream` and `unix_stream` and call `on_event` for each readiness
+// event the connection gets. Plain fields, no atomics: it belongs to the
+// thread that owns the connection. Syscall and event counts are 32 bits
+// (`read_would_block` 31, to leave room for the armed flag) and wrap;
+// compute ratios over deltas on long-lived connections.
+struct io_counters {
+  std::uint64_t bytes_in = 0;
+  std::uint64_t bytes_out = 0;
+  std::uint32_t reads = 0;            // read syscalls, failed ones included
+  std::uint32_t writes = 0;           // write syscalls, failed ones included
+  std::uint32_t write_would_block = 0;
+  std::uint32_t partial_writes = 0;   // accepted fewer bytes than offered
+  std::uint32_t events = 0;           // readiness events delivered
+  std::uint32_t readable_events = 0;  // the readable ones among `events`
+  std::uint32_t spurious = 0;         // readable events whose first read hit EAGAIN
+  std::uint32_t read_would_block : 31 = 0;
+
+  // A writable-only event leaves a pending readable one armed, so a read
+  // deferred past it is still judged against the readable event.
+  void on_event(const event& ev) noexcept {
+    ++events;
+    if (ev.is_readable()) {
+      ++readable_events;
+      read_armed_ = 1;
+    }
+  }
+
+  // Records the outcome of one read and passes it through.
+  auto count_read(result<std::size_t> r) noexcept -> result<std::size_t> {
+    ++reads;
+    if (r.has_value()) {
+      bytes_in += *r;
+    } else if (r.error().is_would_block()) {
+      ++read_would_block;
+      spurious += read_armed_;
+    }
+    read_armed_ = 0;
+    return r;
+  }
+
+  // Records the outcome of one write of `offered` bytes and passes it through.
+  auto count_write(result<std::size_t> r, std::size_t offered) noexcept -> result<std::size_t> {
+    ++writes;
+    if (r.has_value()) {
+      bytes_out += *r;
+      partial_writes += *r < offered ? 1 : 0;
+    } else if (r.error().is_would_block()) {
+      ++write_would_block;
+    }
+    return r;
+  }
+
+  [[nodiscard]] auto bytes_per_read() const noexcept -> double {
+    return reads == 0 ? 0.0 : static_cast<double>(bytes_in) / reads;
+  }
+
+  [[nodiscard]] auto bytes_per_write() const noexcept -> double {
+    return writes == 0 ? 0.0 : static_cast<double>(bytes_out) / writes;
+  }
+
+  // Share of readable events that found nothing to read; writable-only
+  // events cannot be spurious and are left out.
+  [[nodiscard]] auto spurious_ratio() const noexcept -> double {
+    return readable_events == 0 ? 0.0 : static_cast<double>(spurious) / readable_events;
+  }
+
+private:
+  std::uint32_t read_armed_ : 1 = 0;  // shares a word with `read_would_block`
+};
+
+static_assert(sizeof(io_counters) <= 48);
+
+namespace detail {
+
+[[nodiscard]] inline auto iov_bytes(std::span<const iovec> bufs) noexcept -> std::size_t {
+  std::size_t n = 0;
+  for (const auto& b : bufs) {
+    n += b.iov_len;
+  }
+  return n;
+}
+
+}
+
+}
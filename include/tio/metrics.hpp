@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tio/error.hpp>
+#include <tio/stats.hpp>
+
+namespace tio {
+
+enum class metric_kind : std::uint8_t {
+  counter,  // monotonic; readers show a rate
+  gauge,    // current value
+};
+
+struct metric_field {
+  std::string_view name;
+  metric_kind kind = metric_kind::counter;
+};
+
+namespace detail {
+
+// Layout of the shared region. Everything is fixed-size and address-free
+// so another process can map it; bump `k_version` on any change.
+struct metrics_layout {
+  static constexpr std::uint64_t k_magic = 0x3172'7465'6d6f'6974;  // "tiometr1"
+  static constexpr std::uint32_t k_version = 1;
+  static constexpr std::size_t k_fields = 16;
+  static constexpr std::size_t k_label = 48;
+  static constexpr std::size_t k_field_name = 16;
+
+  struct header {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t slot_count;
+    std::int32_t pid;
+    std::atomic<std::uint32_t> used;
+  };
+
+  // Label, field names and kinds are written once before `ready` is set
+  // with release; values are published under the `seq` seqlock.
+  struct slot {
+    std::atomic<std::uint32_t> ready;
+    std::uint32_t field_count;
+    char label[k_label];
+    char field_names[k_fields][k_field_name];
+    metric_kind field_kinds[k_fields];
+    alignas(64) std::atomic<std::uint64_t> seq;
+    std::atomic<std::int64_t> published_ns;
+    std::atomic<std::uint64_t> values[k_fields];
+  };
+
+  // Slots start one cache line in.
+  static constexpr std::size_t k_slots_offset = 64;
+
+  [[nodiscard]] static constexpr auto size(std::uint32_t slots) noexcept -> std::size_t {
+    return k_slots_offset + slots * sizeof(slot);
+  }
+};
+
+static_assert(sizeof(metrics_layout::header) <= metrics_layout::k_slots_offset);
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+}
+
+// Writer handle for one slot of a `metrics_region`. `publish` is a
+// seqlock write: plain stores and two fences, no syscall and no lock, so
+// it can run every loop iteration. One writer per slot.
+class metrics_slot {
+public:
+  void publish(std::span<const std::uint64_t> values) noexcept;
+
+  void publish(std::initializer_list<std::uint64_t> values) noexcept {
+    publish(std::span{values.begin(), values.size()});
+  }
+
+  // For slots from `metrics_region::add_poll`.
+  void publish(const poll_stats& s) noexcept;
+
+private:
+  friend class metrics_region;
+  explicit metrics_slot(detail::metrics_layout::slot* s) noexcept : slot_{s} {}
+
+  detail::metrics_layout::slot* slot_;
+};
+
+// Named shared-memory region (`/dev/shm/<name>`) holding a fixed number of
+// metric slots. Other processes read it with `metrics_reader`, e.g. the
+// `tio_top` tool; reading costs this process nothing. The region is
+// unlinked when the owner is destroyed.
+class metrics_region {
+public:
+  static constexpr std::uint32_t k_default_slots = 64;
+
+  // Fields of slots created by `add_poll`, in `publish(poll_stats)` order.
+  static constexpr std::array<metric_field, 11> k_poll_fields{{
+    {"polls", metric_kind::counter},
+    {"events", metric_kind::counter},
+    {"saturated", metric_kind::counter},
+    {"blocked_ns", metric_kind::counter},
+    {"dispatch_ns", metric_kind::counter},
+    {"ctl_add", metric_kind::counter},
+    {"ctl_mod", metric_kind::counter},
+    {"ctl_del", metric_kind::counter},
+    {"ctl_errors", metric_kind::counter},
+    {"wakes", metric_kind::counter},
+    {"drains", metric_kind::counter},
+  }};
+
+  // `name` is a shm_open name without the leading slash. Fails with EEXIST
+  // while another live process owns a region of that name; a region left
+  // by an owner that died is replaced.
+  [[nodiscard]] static auto create(std::string_view name, std::uint32_t slots = k_default_slots)
+    -> result<metrics_region>;
+
+  metrics_region(metrics_region&& other) noexcept;
+  auto operator=(metrics_region&& other) noexcept -> metrics_region&;
+
+  metrics_region(const metrics_region&) = delete;
+  auto operator=(const metrics_region&) -> metrics_region& = delete;
+
+  ~metrics_region();
+
+  // Claims the next free slot. Fails with ENOSPC when all are taken and
+  // EINVAL for more than 16 fields; long names are truncated.
+  [[nodiscard]] auto add(std::string_view label, std::span<const metric_field> fields) -> result<metrics_slot>;
+
+  [[nodiscard]] auto add(std::string_view label, std::initializer_list<metric_field> fields)
+    -> result<metrics_slot> {
+    return add(label, std::span{fields.begin(), fields.size()});
+  }
+
+  [[nodiscard]] auto add_poll(std::string_view label) -> result<metrics_slot> { return add(label, k_poll_fields); }
+
+  [[nodiscard]] auto name() const noexcept -> const std::string& { return name_; }
+
+private:
+  metrics_region(std::string name, void* base, std::size_t size) noexcept
+    : name_{std::move(name)}, base_{base}, size_{size} {}
+
+  void release() noexcept;
+
+  std::string name_;
+  void* base_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+struct metrics_sample {
+  std::string label;
+  std::vector<std::string> names;
+  std::vector<metric_kind> kinds;
+  std::vector<std::uint64_t> values;
+  std::chrono::nanoseconds published{0};  // CLOCK_MONOTONIC_COARSE at publish
+};
+
+// Read-only mapping of another process's region.
+class metrics_reader {
+public:
+  [[nodiscard]] static auto open(std::string_view name) -> result<metrics_reader>;
+
+  metrics_reader(metrics_reader&& other) noexcept;
+  auto operator=(metrics_reader&& other) noexcept -> metrics_reader&;
+
+  metrics_reader(const metrics_reader&) = delete;
+  auto operator=(const metrics_reader&) -> metrics_reader& = delete;
+
+  ~metrics_reader();
+
+  [[nodiscard]] auto pid() const noexcept -> int;
+
+  // Slots claimed so far.
+  [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+  // Consistent copy of slot `i`; nullopt if it is not ready yet or kept
+  // changing across several retries.
+  [[nodiscard]] auto read(std::size_t i) const -> std::optional<metrics_sample>;
+
+private:
+  metrics_reader(void* base, std::size_t size) noexcept : base_{base}, size_{size} {}
+
+  void release() noexcept;
+
+  void* base_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+#include <tio/error.hpp>
+#include <tio/event.hpp>
+#include <tio/net/tcp_listener.hpp>
+#include <tio/net/tcp_stream.hpp>
+#include <tio/poll.hpp>
+#include <tio/sys/detail/socket_addr.hpp>
+#include <tio/sys/detail/spsc_ring.hpp>
+#include <tio/token.hpp>
+#include <tio/waker.hpp>
+
+namespace tio::net {
+
+enum class placement : std::uint8_t {
+  round_robin,
+  least_connections,
+  // Worker whose CPU matches the socket's SO_INCOMING_CPU; see
+  // `acceptor_options::worker_cpus`.
+  incoming_cpu,
+};
+
+struct acceptor_options {
+  placement place = placement::round_robin;
+  // Per-worker inbox size; a full inbox makes placement try the next worker.
+  std::size_t queue_capacity = 1024;
+  // Upper bound on accept() calls per readiness round.
+  std::size_t max_batch = 256;
+  // CPU each worker runs on, indexed like add_worker() calls. When empty,
+  // incoming_cpu placement maps CPU c to worker c % n.
+  std::vector<int> worker_cpus;
+  // Retry delay after accept() fails for lack of fds or memory (EMFILE,
+  // ENFILE, ENOBUFS, ENOMEM). The backlog is left in place and retried.
+  std::chrono::milliseconds resource_retry{10};
+};
+
+using accepted = std::pair<tcp_stream, detail::socket_addr>;
+
+// Worker side of the handoff. Owned by the acceptor; the pointer returned
+// by `acceptor::add_worker` stays valid for the acceptor's lifetime.
+class acceptor_inbox {
+public:
+  acceptor_inbox(waker w, std::size_t capacity) : wake_{std::move(w)}, ring_{capacity} {}
+
+  acceptor_inbox(const acceptor_inbox&) = delete;
+  auto operator=(const acceptor_inbox&) -> acceptor_inbox& = delete;
+
+  // Worker thread. Call when an event with the inbox token is returned;
+  // `fn(tcp_stream, socket_addr)` runs for each handed-off connection.
+  template <typename fn_t>
+  auto drain(fn_t&& fn) -> std::size_t {
+    wake_.drain();
+    // Clearing the flag before emptying the ring means a push that races
+    // with this drain either lands in it or sees the flag clear and wakes.
+    pending_.exchange(false, std::memory_order_seq_cst);
+
+    std::size_t n = 0;
+    while (auto c = ring_.try_pop()) {
+      fn(std::move(c->first), c->second);
+      ++n;
+    }
+    return n;
+  }
+
+  // Worker thread: a connection handed off through this inbox was closed.
+  // Feeds least_connections placement.
+  void connection_closed() noexcept { live_.fetch_sub(1, std::memory_order_relaxed); }
+
+  [[nodiscard]] auto live_connections() const noexcept -> std::size_t {
+    return live_.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto wake_count() const noexcept -> std::uint64_t {
+    return wakes_.load(std::memory_order_relaxed);
+  }
+
+private:
+  friend class acceptor;
+
+  [[nodiscard]] auto try_push(accepted& c) -> bool {
+    if (!ring_.try_push(c)) {
+      return false;
+    }
+    live_.fetch_add(1, std::memory_order_relaxed);
+    dirty_ = true;
+    return true;
+  }
+
+  void flush() noexcept {
+    if (!std::exchange(dirty_, false)) {
+      return;
+    }
+    if (!pending_.exchange(true, std::memory_order_seq_cst)) {
+      wakes_.fetch_add(1, std::memory_order_relaxed);
+      [[maybe_unused]] auto r = wake_.wake();
+    }
+  }
+
+  waker wake_;
+  detail::spsc_ring<accepted> ring_;
+  std::atomic<bool> pending_{false};
+  std::atomic<std::size_t> live_{0};
+  std::atomic<std::uint64_t> wakes_{0};
+  bool dirty_ = false;
+};
+
+// Single listener, many worker polls. The acceptor thread drains accept()
+// in bulk, places each connection on a worker inbox (an SPSC ring), and
+// wakes each worker at most once per batch.
+class acceptor {
+public:
+  static constexpr auto k_listener_token = token{0};
+  static constexpr auto k_stop_token = token{1};
+
+  [[nodiscard]] static auto create(tcp_listener listener, const acceptor_options& opts = {})
+      -> result<acceptor>;
+
+  acceptor(acceptor&&) noexcept = default;
+  auto operator=(acceptor&&) noexcept -> acceptor& = default;
+
+  acceptor(const acceptor&) = delete;
+  auto operator=(const acceptor&) -> acceptor& = delete;
+
+  // Adds a worker whose poll gets a readable event on `tok` when
+  // connections are waiting. Not thread-safe; call before running.
+  [[nodiscard]] auto add_worker(const registry& reg, token tok) -> result<acceptor_inbox*>;
+
+  // Acceptor thread: waits for the listener, then accepts one batch.
+  [[nodiscard]] auto run_once(std::optional<std::chrono::milliseconds> timeout) -> void_result;
+
+  // Acceptor thread: loops run_once until `stop` is requested.
+  [[nodiscard]] auto run(std::stop_token stop) -> void_result;
+
+  // Accepts up to `max_batch` connections without waiting and hands them
+  // off. Returns how many were handed off.
+  [[nodiscard]] auto accept_batch() -> result<std::size_t>;
+
+  [[nodiscard]] auto worker_count() const noexcept -> std::size_t { return state_->inboxes.size(); }
+
+  [[nodiscard]] auto accepted_count() const noexcept -> std::uint64_t { return state_->accepted_total; }
+
+  // accept() calls that failed for lack of fds or memory.
+  [[nodiscard]] auto resource_errors() const noexcept -> std::uint64_t { return state_->resource_errors; }
+
+  // True while a connection is held back because every inbox was full.
+  [[nodiscard]] auto is_stalled() const noexcept -> bool { return state_->stalled.has_value(); }
+
+private:
+  struct state {
+    state(tcp_listener l, tio::poll p, waker w, const acceptor_options& o)
+      : listener{std::move(l)}, poll{std::move(p)}, stop_waker{std::move(w)}, opts{o} {}
+
+    tcp_listener listener;
+    tio::poll poll;
+    waker stop_waker;
+    acceptor_options opts;
+    events evs{4};
+    std::vector<std::unique_ptr<acceptor_inbox>> inboxes;
+    std::optional<accepted> stalled;
+    std::size_t next = 0;
+    std::uint64_t accepted_total = 0;
+    std::uint64_t resource_errors = 0;
+    bool more = false;
+    // Last batch hit a resource error; retry after `opts.resource_retry`.
+    bool starved = false;
+  };
+
+  explicit acceptor(std::unique_ptr<state> s) noexcept : state_{std::move(s)} {}
+
+  [[nodiscard]] auto pick(const accepted& c) -> std::size_t;
+  [[nodiscard]] auto hand_off(accepted& c) -> bool;
+
+  std::unique_ptr<state> state_;
+};
+
+}
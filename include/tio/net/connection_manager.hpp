@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <tio/clock.hpp>
+#include <tio/error.hpp>
+#include <tio/net/tcp_listener.hpp>
+#include <tio/net/tcp_stream.hpp>
+#include <tio/poll.hpp>
+#include <tio/sys/detail/timer_wheel.hpp>
+#include <tio/token.hpp>
+
+namespace tio::net {
+
+struct connection_options {
+  // Slots are preallocated; reaching the cap pauses accepting.
+  std::size_t max_connections = 1024;
+  std::chrono::milliseconds idle_timeout{30'000};
+  // Timer wheel resolution; idle connections close up to one tick late.
+  std::chrono::milliseconds tick{100};
+  std::size_t wheel_slots = 512;
+  // Connection tokens are base_token + slot.
+  token base_token{16};
+};
+
+enum class close_reason : std::uint8_t { idle, drained };
+
+// Owns a listener and the connections accepted from it. Connections live in
+// preallocated slots addressed by token; activity is recorded with a plain
+// store (`touch`) and checked lazily when the connection's wheel bucket comes
+// up, so the per-event path never allocates or touches the wheel.
+class connection_manager {
+public:
+  [[nodiscard]] static auto create(
+    registry reg,
+    tcp_listener listener,
+    token listener_tok,
+    const connection_options& opts = {}
+  ) -> result<connection_manager>;
+
+  connection_manager(connection_manager&&) noexcept = default;
+  auto operator=(connection_manager&&) noexcept -> connection_manager& = default;
+
+  connection_manager(const connection_manager&) = delete;
+  auto operator=(const connection_manager&) -> connection_manager& = delete;
+
+  // Call on a listener event. Accepts until EAGAIN or the cap, registering
+  // each connection readable|writable under its slot token. Returns how many
+  // were accepted; `on_accept(token, tcp_stream&)` runs for each.
+  template <typename fn_t>
+  auto accept_ready(loop_clock::time_point now, fn_t&& on_accept) -> result<std::size_t>;
+
+  [[nodiscard]] auto accept_ready(loop_clock::time_point now) -> result<std::size_t> {
+    return accept_ready(now, [](token, tcp_stream&) {});
+  }
+
+  [[nodiscard]] auto find(token tok) noexcept -> tcp_stream*;
+
+  // Records activity on `tok`; O(1), no wheel operation.
+  void touch(token tok, loop_clock::time_point now) noexcept;
+
+  // Busy connections never idle out and survive a drain until released.
+  void set_busy(token tok, bool busy) noexcept;
+
+  // Deregisters and closes `tok`, freeing its slot; resumes accepting if
+  // the manager was paused at the cap.
+  void close(token tok) noexcept;
+
+  // Advances the wheel to `now` and closes connections that have been idle
+  // for `idle_timeout`, plus, while draining, every non-busy connection (or
+  // all of them once the drain deadline passed). `on_close(token, reason)`
+  // runs before each close. Returns how many were closed.
+  template <typename fn_t>
+  auto expire(loop_clock::time_point now, fn_t&& on_close) -> std::size_t;
+
+  auto expire(loop_clock::time_point now) -> std::size_t {
+    return expire(now, [](token, close_reason) {});
+  }
+
+  // Stops accepting for good; in-flight connections get until
+  // `now + grace` to finish before `expire` closes them regardless.
+  void begin_drain(loop_clock::time_point now, std::chrono::milliseconds grace) noexcept;
+
+  // Poll timeout from `now` until the next wheel bucket is due, rounded up
+  // to whole milliseconds; nullopt when nothing is scheduled.
+  [[nodiscard]] auto next_timeout(loop_clock::time_point now) const noexcept
+    -> std::optional<std::chrono::milliseconds>;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return state_->live; }
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return state_->slots.size(); }
+
+  [[nodiscard]] auto is_paused() const noexcept -> bool { return state_->paused; }
+
+  [[nodiscard]] auto is_draining() const noexcept -> bool { return state_->draining; }
+
+  [[nodiscard]] auto is_drained() const noexcept -> bool {
+    return state_->draining && state_->live == 0;
+  }
+
+  [[nodiscard]] auto listener() const noexcept -> const tcp_listener& { return state_->listener; }
+
+private:
+  static constexpr std::uint32_t k_no_slot = std::numeric_limits<std::uint32_t>::max();
+
+  struct slot : detail::wheel_node {
+    std::optional<tcp_stream> stream;
+    loop_clock::time_point last_active{};
+    slot* next_expired = nullptr;
+    std::uint32_t next_free = k_no_slot;
+    bool busy = false;
+  };
+
+  struct state {
+    state(registry r, tcp_listener l, token lt, const connection_options& o)
+      : reg{std::move(r)}, listener{std::move(l)}, listener_tok{lt}, opts{o},
+        slots(o.max_connections), wheel{o.wheel_slots} {}
+
+    registry reg;
+    tcp_listener listener;
+    token listener_tok;
+    connection_options opts;
+    std::vector<slot> slots;
+    detail::timer_wheel wheel;
+    loop_clock::time_point epoch{};
+    loop_clock::time_point drain_deadline{};
+    std::uint32_t free_head = k_no_slot;
+    std::size_t live = 0;
+    bool paused = false;
+    bool draining = false;
+    bool epoch_set = false;
+  };
+
+  explicit connection_manager(std::unique_ptr<state> s) noexcept : state_{std::move(s)} {}
+
+  [[nodiscard]] auto slot_of(token tok) noexcept -> slot*;
+  [[nodiscard]] auto token_of(const slot& s) const noexcept -> token;
+  void start_clock(loop_clock::time_point now) noexcept;
+  [[nodiscard]] auto tick_of(loop_clock::time_point t) const noexcept -> std::uint64_t;
+  [[nodiscard]] auto admit(tcp_stream stream, loop_clock::time_point now) -> result<slot*>;
+  void schedule_idle(slot& s) noexcept;
+  void pause() noexcept;
+  void resume() noexcept;
+  auto collect_expired(loop_clock::time_point now) -> slot*;
+
+  std::unique_ptr<state> state_;
+};
+
+template <typename fn_t>
+auto connection_manager::accept_ready(const loop_clock::time_point now, fn_t&& on_accept)
+    -> result<std::size_t> {
+  std::size_t n = 0;
+  while (!state_->paused && !state_->draining) {
+    auto c = state_->listener.accept();
+    if (!c.has_value()) {
+      if (c.error().is_would_block()) {
+        break;
+      }
+      if (c.error().is_connection_aborted() || c.error().is_interrupted()) {
+        continue;
+      }
+      return std::unexpected{c.error()};
+    }
+
+    auto s = admit(std::move(c->first), now);
+    if (!s.has_value()) {
+      return std::unexpected{s.error()};
+    }
+    on_accept(token_of(**s), *(*s)->stream);
+    ++n;
+  }
+  return n;
+}
+
+template <typename fn_t>
+auto connection_manager::expire(const loop_clock::time_point now, fn_t&& on_close) -> std::size_t {
+  std::size_t n = 0;
+  slot* s = collect_expired(now);
+  while (s != nullptr) {
+    slot* next = std::exchange(s->next_expired, nullptr);
+    const auto reason = state_->draining ? close_reason::drained : close_reason::idle;
+    const auto tok = token_of(*s);
+    on_close(tok, reason);
+    close(tok);
+    ++n;
+    s = next;
+  }
+  return n;
+}
+
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <tio/error.hpp>
+#include <tio/interest.hpp>
+#include <tio/net/tcp_listener.hpp>
+#include <tio/poll.hpp>
+#include <tio/source.hpp>
+#include <tio/sys/detail/fd_guard.hpp>
+#include <tio/token.hpp>
+
+namespace tio::net {
+
+// Accept queue of one watched listener, as reported by inet_diag.
+struct listen_queue {
+  std::uint64_t inode = 0;
+  std::uint16_t port = 0;      // host byte order
+  std::uint32_t queued = 0;    // handshakes completed but not yet accepted
+  std::uint32_t backlog = 0;   // listen() backlog, capped by net.core.somaxconn
+
+  // Share of the backlog in use; at 1.0 the kernel starts dropping.
+  [[nodiscard]] auto fill() const noexcept -> double {
+    return backlog == 0 ? 0.0 : static_cast<double>(queued) / static_cast<double>(backlog);
+  }
+};
+
+// TcpExt counters from /proc/net/netstat. They cover every listener in
+// the network namespace, not just the watched ones.
+struct listen_drops {
+  std::uint64_t overflows = 0;  // ListenOverflows: accept queue was full
+  std::uint64_t drops = 0;      // ListenDrops: any SYN or ACK dropped by a listener
+};
+
+struct listen_sample {
+  // Watched listeners that were found; closed ones are left out.
+  std::vector<listen_queue> listeners;
+  listen_drops total;
+  // Growth since the previous sample; zero on the first.
+  listen_drops delta;
+};
+
+// Samples the accept queues of a set of TCP listeners over a
+// NETLINK_SOCK_DIAG socket and pairs them with the TcpExt listen drop
+// counters. The netlink socket is non-blocking and is a `source`: call
+// `begin()` on a timer, register the monitor for readable, and feed
+// readiness to `on_readable()` until it returns a sample. `sample()` does
+// the same round trip synchronously for a dedicated sampling thread.
+class listen_monitor {
+public:
+  [[nodiscard]] static auto create() -> result<listen_monitor>;
+
+  listen_monitor(listen_monitor&&) noexcept = default;
+  auto operator=(listen_monitor&&) noexcept -> listen_monitor& = default;
+
+  listen_monitor(const listen_monitor&) = delete;
+  auto operator=(const listen_monitor&) -> listen_monitor& = delete;
+
+  // Listeners are matched by socket inode, so the monitor keeps working
+  // if the fd number is reused. Watching the same socket twice is a no-op.
+  [[nodiscard]] auto watch(const tcp_listener& listener) -> void_result { return watch_fd(listener.raw_fd()); }
+
+  [[nodiscard]] auto watch_fd(int listener_fd) -> void_result;
+
+  // Sends the dump request for the next sample. Fails with EALREADY while
+  // one is in flight and EINVAL when nothing is watched.
+  [[nodiscard]] auto begin() -> void_result;
+
+  // Consumes whatever replies are queued. Returns the sample once every
+  // dump has completed and nullopt while more replies are due.
+  [[nodiscard]] auto on_readable() -> result<std::optional<listen_sample>>;
+
+  // `begin()` plus waiting on the socket; ETIMEDOUT if the kernel does not
+  // finish the dump within `timeout`.
+  [[nodiscard]] auto sample(std::chrono::milliseconds timeout = std::chrono::milliseconds{1000})
+    -> result<listen_sample>;
+
+  [[nodiscard]] auto in_flight() const noexcept -> bool { return dumping_ != 0; }
+
+  [[nodiscard]] static auto read_drops() -> result<listen_drops>;
+
+  [[nodiscard]] auto raw_fd() const noexcept -> int { return fd_.raw_fd(); }
+
+  [[nodiscard]] auto tio_register(const registry& reg, token tok, interest intr) -> void_result {
+    return reg.register_fd(fd_.raw_fd(), tok, intr);
+  }
+
+  [[nodiscard]] auto tio_reregister(const registry& reg, token tok, interest intr) -> void_result {
+    return reg.reregister_fd(fd_.raw_fd(), tok, intr);
+  }
+
+  [[nodiscard]] auto tio_deregister(const registry& reg) -> void_result {
+    return reg.deregister_fd(fd_.raw_fd());
+  }
+
+private:
+  struct watched {
+    std::uint64_t inode;
+    int family;
+  };
+
+  explicit listen_monitor(detail::fd_guard fd) : fd_{std::move(fd)}, buf_(k_recv_buffer) {}
+
+  [[nodiscard]] auto request(int family) -> void_result;
+  [[nodiscard]] auto finish() -> result<listen_sample>;
+  void reset() noexcept;
+
+  // Large enough for the biggest dump skb the kernel builds (32 KiB).
+  static constexpr std::size_t k_recv_buffer = 32768;
+
+  detail::fd_guard fd_;
+  std::vector<watched> watched_;
+  std::vector<std::byte> buf_;
+  std::vector<listen_queue> partial_;
+  std::optional<listen_drops> last_;
+  std::uint32_t seq_ = 0;
+  // Family of the dump in flight, or 0. IPv4 listeners are dumped first,
+  // then IPv6; the kernel runs one dump per socket at a time.
+  int dumping_ = 0;
+};
+
+static_assert(source<listen_monitor>);
+
+}
@@ -20,6 +20,7 @@
 
 #include <tio/error.hpp>
 #include <tio/interest.hpp>
+#include <tio/io_counters.hpp>
 #include <tio/poll.hpp>
 #include <tio/source.hpp>
 #include <tio/sys/detail/fd_guard.hpp>
@@ -44,6 +45,8 @@ public:
   tcp_stream(const tcp_stream&) = delete;
   auto operator=(const tcp_stream&) -> tcp_stream& = delete;
 
+  // Out of line so the USDT probes in libtio fire for every caller; each
+  // is one call that makes the syscall and nothing else.
   [[nodiscard]] auto read(std::span<std::byte> buf) const -> result<std::size_t>;
 
   [[nodiscard]] auto write(std::span<const std::byte> buf) const -> result<std::size_t>;
@@ -66,10 +69,30 @@ public:
 
   [[nodiscard]] auto take_error() const -> result<error>;
 
+  // CPU whose receive path last handled this socket (SO_INCOMING_CPU).
+  [[nodiscard]] auto incoming_cpu() const -> result<int>;
+
   [[nodiscard]] auto read_vectored(std::span<iovec> bufs) const -> result<std::size_t>;
 
   [[nodiscard]] auto write_vectored(std::span<const iovec> bufs) const -> result<std::size_t>;
 
+  // Same calls, also recorded in the connection's `io_counters`.
+  [[nodiscard]] auto read(std::span<std::byte> buf, io_counters& c) const -> result<std::size_t> {
+    return c.count_read(read(buf));
+  }
+
+  [[nodiscard]] auto write(std::span<const std::byte> buf, io_counters& c) const -> result<std::size_t> {
+    return c.count_write(write(buf), buf.size());
+  }
+
+  [[nodiscard]] auto read_vectored(std::span<iovec> bufs, io_counters& c) const -> result<std::size_t> {
+    return c.count_read(read_vectored(bufs));
+  }
+
+  [[nodiscard]] auto write_vectored(std::span<const iovec> bufs, io_counters& c) const -> result<std::size_t> {
+    return c.count_write(write_vectored(bufs), detail::iov_bytes(bufs));
+  }
+
   [[nodiscard]] auto raw_fd() const noexcept -> int { return fd_.raw_fd(); }
 
   auto into_raw_fd() noexcept -> int { return fd_.release(); }
@@ -21,6 +21,7 @@
 #include <tio/error.hpp>
 #include <tio/interest.hpp>
 #include <tio/poll.hpp>
+#include <tio/rx_drops.hpp>
 #include <tio/source.hpp>
 #include <tio/sys/detail/fd_guard.hpp>
 #include <tio/sys/detail/socket_addr.hpp>
@@ -54,6 +55,14 @@ public:
 
   [[nodiscard]] auto recv(std::span<std::byte> buf) const -> result<std::size_t>;
 
+  // Like `recv_from` / `recv`, and feeds the SO_RXQ_OVFL drop counter the
+  // kernel attached to the datagram into `drops`. Needs
+  // `set_rxq_overflow(true)`; otherwise `drops` never moves.
+  [[nodiscard]] auto recv_from(std::span<std::byte> buf, rx_drops& drops) const
+      -> result<std::pair<std::size_t, detail::socket_addr>>;
+
+  [[nodiscard]] auto recv(std::span<std::byte> buf, rx_drops& drops) const -> result<std::size_t>;
+
   [[nodiscard]] auto peek(std::span<std::byte> buf) const -> result<std::size_t>;
 
   [[nodiscard]] auto peek_from(std::span<std::byte> buf) const
@@ -65,6 +74,10 @@ public:
 
   [[nodiscard]] auto broadcast() const -> result<bool>;
 
+  [[nodiscard]] auto set_rxq_overflow(bool enable) const -> void_result;
+
+  [[nodiscard]] auto rxq_overflow() const -> result<bool>;
+
   [[nodiscard]] auto peer_addr() const -> result<detail::socket_addr>;
 
   [[nodiscard]] auto set_ttl(std::uint32_t ttl) const -> void_result;
@@ -12,17 +12,61 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <utility>
 
+#include <tio/clock.hpp>
 #include <tio/error.hpp>
 #include <tio/event.hpp>
+#include <tio/flight_recorder.hpp>
 #include <tio/interest.hpp>
 #include <tio/source.hpp>
+#include <tio/stats.hpp>
+#include <tio/sys/detail/registration_table.hpp>
 #include <tio/sys/selector.hpp>
 #include <tio/token.hpp>
 
 namespace tio {
 
+namespace detail {
+
+struct watchdog_state;
+
+// Heap-allocated so registries stay valid when the owning poll is moved.
+// The selector is only waited on by the poll thread; epoll_ctl itself is
+// safe from any thread, and `table_mu` only serialises registrations.
+// `stats` and `recorder` are shared so wakers can keep writing to them
+// after the poll is gone.
+struct poll_state : std::enable_shared_from_this<poll_state> {
+  poll_state(
+    sys::selector s,
+    bool track,
+    bool collect_stats,
+    std::unique_ptr<poll_latency> lat,
+    std::shared_ptr<flight_recorder> rec
+  )
+    : sel{std::move(s)}, table{track ? std::make_unique<registration_table>() : nullptr},
+      stats{collect_stats ? std::make_shared<poll_counters>() : nullptr}, latency{std::move(lat)},
+      recorder{std::move(rec)} {}
+
+  sys::selector sel;
+  std::unique_ptr<registration_table> table;
+  std::mutex table_mu;
+  std::shared_ptr<poll_counters> stats;
+  std::unique_ptr<poll_latency> latency;
+  std::shared_ptr<flight_recorder> recorder;
+  alignas(64) heartbeat beat;
+};
+
+}
+
+// `poll::get_registry()` hands out a borrowed registry that is valid as long
+// as the poll (moved or not) is alive and is meant for the poll thread.
+// `try_clone()` returns an owning registry that shares the poll's state; it
+// can be sent to and used from any thread, and keeps the selector alive.
 class registry {
 public:
   [[nodiscard]] auto register_fd(int fd, token tok, interest interest) const -> void_result;
@@ -46,17 +90,85 @@ public:
 
   [[nodiscard]] auto try_clone() const -> result<registry>;
 
+  [[nodiscard]] auto is_tracking() const noexcept -> bool { return state_->table != nullptr; }
+
+  [[nodiscard]] auto is_owning() const noexcept -> bool { return owner_ != nullptr; }
+
+  // Only available when the poll was created with `track_registrations`;
+  // otherwise nothing is known and these report empty.
+  [[nodiscard]] auto registration_of(int fd) const -> std::optional<registration>;
+
+  [[nodiscard]] auto registered_count() const -> std::size_t;
+
+  [[nodiscard]] auto elided_count() const -> std::size_t;
+
+  // Lock-free snapshot of the poll's counters, safe from any thread;
+  // nullopt unless the poll was created with `collect_stats`.
+  [[nodiscard]] auto stats() const noexcept -> std::optional<poll_stats>;
+
+  // Live latency histograms, readable from any thread via `snapshot()`;
+  // null unless the poll was created with `record_latency`. Valid while
+  // this registry is.
+  [[nodiscard]] auto latency() const noexcept -> const poll_latency* { return state_->latency.get(); }
+
+  // The poll's flight recorder, null unless created with `flight_records`.
+  // Recording and dumping are both safe from any thread.
+  [[nodiscard]] auto recorder() const noexcept -> flight_recorder* { return state_->recorder.get(); }
+
+  template <typename fn_t>
+  void for_each_registration(fn_t&& fn) const {
+    if (state_->table != nullptr) {
+      const std::lock_guard lock{state_->table_mu};
+      state_->table->for_each(std::forward<fn_t>(fn));
+    }
+  }
+
 private:
   friend class poll;
-  explicit registry(sys::selector* sel) noexcept : sel_{sel} {}
+  friend class waker;
+  friend struct detail::watchdog_state;
+  explicit registry(detail::poll_state* state) noexcept : state_{state} {}
+  explicit registry(std::shared_ptr<detail::poll_state> owner) noexcept
+    : state_{owner.get()}, owner_{std::move(owner)} {}
+
+  detail::poll_state* state_;
+  std::shared_ptr<detail::poll_state> owner_;
+};
 
-  sys::selector* sel_;
+struct poll_options {
+  clock_mode clock = clock_mode::precise;
+
+  // Keep an fd-indexed shadow of every registration (9 bytes per fd).
+  // Redundant reregisters are elided and double registration fails with
+  // EEXIST before reaching the kernel. Sources must be deregistered
+  // before their fd is closed, or a reused fd number will look taken.
+  bool track_registrations = false;
+
+  // Count polls, batch sizes, blocked vs dispatch time, epoll_ctl calls
+  // and waker traffic (see `poll_stats`). Costs one extra clock sample
+  // and a few relaxed stores per `do_poll`.
+  bool collect_stats = false;
+
+  // Record every wait and dispatch duration into histograms (see
+  // `poll_latency`), plus `handler_classes` histograms filled by
+  // `poll::record_handler`. Allocated once at creation (~18 KiB each);
+  // recording is a few relaxed atomic adds.
+  bool record_latency = false;
+  std::size_t handler_classes = 0;
+
+  // Keep the last `flight_records` loop events (waits, registrations,
+  // wakes, and dispatches marked with `flight_scope`) in a ring that can
+  // be dumped as a Chrome/Perfetto trace. 0 disables it; 64 bytes per
+  // record.
+  std::size_t flight_records = 0;
 };
 
 class poll {
 public:
   [[nodiscard]] static auto create() -> result<poll>;
 
+  [[nodiscard]] static auto create(const poll_options& opts) -> result<poll>;
+
   poll(poll&&) noexcept = default;
   auto operator=(poll&&) noexcept -> poll& = default;
 
@@ -68,12 +180,41 @@ public:
     std::optional<std::chrono::milliseconds> timeout
   ) -> void_result;
 
-  [[nodiscard]] auto get_registry() -> registry { return registry{&sel_}; }
+  [[nodiscard]] auto get_registry() -> registry { return registry{state_.get()}; }
+
+  // Time at which the last `do_poll` returned.
+  [[nodiscard]] auto loop_now() const noexcept -> loop_clock::time_point { return clock_.now(); }
+
+  [[nodiscard]] auto clock() const noexcept -> const loop_clock& { return clock_; }
+
+  void set_clock_mode(clock_mode mode) noexcept { clock_.set_mode(mode); }
+
+  [[nodiscard]] auto stats() const noexcept -> std::optional<poll_stats> {
+    if (state_->stats == nullptr) {
+      return std::nullopt;
+    }
+    return state_->stats->snapshot();
+  }
+
+  [[nodiscard]] auto latency() const noexcept -> const poll_latency* { return state_->latency.get(); }
+
+  [[nodiscard]] auto recorder() const noexcept -> flight_recorder* { return state_->recorder.get(); }
+
+  // Records the time from the last `do_poll` return until now against
+  // handler class `cls`; call when that class's handler completes. No-op
+  // without `record_latency` or for an out-of-range class.
+  void record_handler(std::size_t cls) noexcept;
+
+  // Names the token whose handler is about to run, so a `watchdog` can
+  // report it if the loop stalls. Cleared by the next `do_poll`.
+  void mark_dispatch(token tok) noexcept;
 
 private:
-  explicit poll(sys::selector sel) noexcept;
+  poll(std::shared_ptr<detail::poll_state> state, const poll_options& opts) noexcept;
 
-  sys::selector sel_;
+  std::shared_ptr<detail::poll_state> state_;
+  loop_clock clock_;
+  bool primed_ = false;
 };
 
 }
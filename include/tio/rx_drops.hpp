@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace tio {
+
+// Running tally of one datagram socket's receive-queue drops, built from
+// the SO_RXQ_OVFL counter the kernel attaches to each datagram. Keep one
+// next to the socket and pass it to the counting `recv` / `recv_from`
+// overloads. The kernel counter is 32 bits and wraps; the tally does not.
+class rx_drops {
+public:
+  // Feeds the counter carried by one datagram. Returns how many datagrams
+  // were dropped between it and the previously observed one.
+  auto observe(std::uint32_t counter) noexcept -> std::uint32_t {
+    last_ = counter - counter_;
+    counter_ = counter;
+    total_ += last_;
+    return last_;
+  }
+
+  // Drops seen so far. The kernel counts from socket creation, so the
+  // first observation also includes drops from before SO_RXQ_OVFL was on.
+  [[nodiscard]] auto total() const noexcept -> std::uint64_t { return total_; }
+
+  // Drops right before the most recent datagram.
+  [[nodiscard]] auto last() const noexcept -> std::uint32_t { return last_; }
+
+  // Raw kernel counter from the most recent datagram that carried one.
+  [[nodiscard]] auto counter() const noexcept -> std::uint32_t { return counter_; }
+
+private:
+  std::uint64_t total_ = 0;
+  std::uint32_t counter_ = 0;
+  std::uint32_t last_ = 0;
+};
+
+}
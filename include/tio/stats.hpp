@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <tio/clock.hpp>
+#include <tio/histogram.hpp>
+
+namespace tio {
+
+// Copy of a poll's counters at one point in time. Batch sizes are bucketed
+// by power of two: bucket 0 counts empty returns, bucket i (i >= 1) counts
+// returns of [2^(i-1), 2^i) events, and the last bucket everything larger.
+struct poll_stats {
+  static constexpr std::size_t k_batch_buckets = 16;
+
+  std::uint64_t polls = 0;
+  std::uint64_t events = 0;
+  // Returns that filled the whole `events` buffer; more were likely pending.
+  std::uint64_t saturated = 0;
+  std::array<std::uint64_t, k_batch_buckets> batch_sizes{};
+
+  // Time inside the selector wait versus time between a `do_poll` return
+  // and the next call, i.e. spent by the caller handling events.
+  std::chrono::nanoseconds blocked{0};
+  std::chrono::nanoseconds dispatching{0};
+
+  std::uint64_t ctl_add = 0;
+  std::uint64_t ctl_mod = 0;
+  std::uint64_t ctl_del = 0;
+  std::uint64_t ctl_errors = 0;
+
+  std::uint64_t wakes = 0;
+  std::uint64_t drains = 0;
+
+  [[nodiscard]] static constexpr auto batch_bucket(std::size_t n) noexcept -> std::size_t {
+    const auto b = static_cast<std::size_t>(std::bit_width(n));
+    return b < k_batch_buckets ? b : k_batch_buckets - 1;
+  }
+};
+
+// Latency distributions kept by a poll created with `record_latency`.
+// `wait` is the time inside each selector wait, `dispatch` the time from
+// one `do_poll` return to the next call. Handler classes are small indices
+// chosen by the caller (e.g. listener, client, timer) and filled through
+// `poll::record_handler`; their count is fixed at creation.
+class poll_latency {
+public:
+  explicit poll_latency(std::size_t handler_classes)
+    : handlers_{std::make_unique<latency_histogram[]>(handler_classes)}, handler_classes_{handler_classes} {}
+
+  latency_histogram wait;
+  latency_histogram dispatch;
+
+  [[nodiscard]] auto handler(std::size_t cls) noexcept -> latency_histogram& { return handlers_[cls]; }
+
+  [[nodiscard]] auto handler(std::size_t cls) const noexcept -> const latency_histogram& { return handlers_[cls]; }
+
+  [[nodiscard]] auto handler_classes() const noexcept -> std::size_t { return handler_classes_; }
+
+private:
+  std::unique_ptr<latency_histogram[]> handlers_;
+  std::size_t handler_classes_;
+};
+
+namespace detail {
+
+// Live counters behind `poll_stats`. The `do_poll` fields have a single
+// writer (the poll thread) and are bumped with a relaxed load and store;
+// registration and waker fields may be written from any thread and use
+// fetch_add. Readers on other threads take relaxed loads, so a snapshot
+// is lock-free but not one consistent cut.
+struct poll_counters {
+  std::atomic<std::uint64_t> polls{0};
+  std::atomic<std::uint64_t> events{0};
+  std::atomic<std::uint64_t> saturated{0};
+  std::array<std::atomic<std::uint64_t>, poll_stats::k_batch_buckets> batch_sizes{};
+  std::atomic<std::int64_t> blocked_ns{0};
+  std::atomic<std::int64_t> dispatching_ns{0};
+
+  alignas(64) std::atomic<std::uint64_t> ctl_add{0};
+  std::atomic<std::uint64_t> ctl_mod{0};
+  std::atomic<std::uint64_t> ctl_del{0};
+  std::atomic<std::uint64_t> ctl_errors{0};
+
+  alignas(64) std::atomic<std::uint64_t> wakes{0};
+  std::atomic<std::uint64_t> drains{0};
+
+  template <typename t_t>
+  static void bump(std::atomic<t_t>& c, t_t by = 1) noexcept {
+    c.store(c.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+  }
+
+  void on_poll(std::size_t n, std::size_t capacity, std::chrono::nanoseconds blocked,
+               std::chrono::nanoseconds dispatching) noexcept {
+    bump(polls);
+    bump(events, static_cast<std::uint64_t>(n));
+    if (n == capacity) {
+      bump(saturated);
+    }
+    bump(batch_sizes[poll_stats::batch_bucket(n)]);
+    bump(blocked_ns, static_cast<std::int64_t>(blocked.count()));
+    bump(dispatching_ns, static_cast<std::int64_t>(dispatching.count()));
+  }
+
+  [[nodiscard]] auto snapshot() const noexcept -> poll_stats {
+    constexpr auto r = std::memory_order_relaxed;
+    poll_stats s;
+    s.polls = polls.load(r);
+    s.events = events.load(r);
+    s.saturated = saturated.load(r);
+    for (std::size_t i = 0; i < s.batch_sizes.size(); ++i) {
+      s.batch_sizes[i] = batch_sizes[i].load(r);
+    }
+    s.blocked = std::chrono::nanoseconds{blocked_ns.load(r)};
+    s.dispatching = std::chrono::nanoseconds{dispatching_ns.load(r)};
+    s.ctl_add = ctl_add.load(r);
+    s.ctl_mod = ctl_mod.load(r);
+    s.ctl_del = ctl_del.load(r);
+    s.ctl_errors = ctl_errors.load(r);
+    s.wakes = wakes.load(r);
+    s.drains = drains.load(r);
+    return s;
+  }
+};
+
+// Liveness of one poll, written only by its thread with relaxed stores and
+// read by a `watchdog`. `in_select` is set around the selector wait;
+// `returned_ns` is the loop clock at the last return, and `tok`/`tok_ns`
+// the token last passed to `poll::mark_dispatch` in this iteration. Both
+// times come from the clock named by `mode`, which the reader must sample
+// too: coarse and precise readings differ by up to a jiffy.
+struct heartbeat {
+  static constexpr std::uint64_t k_no_token = ~std::uint64_t{0};
+
+  std::atomic<std::uint64_t> iterations{0};
+  std::atomic<std::int64_t> returned_ns{0};
+  std::atomic<clock_mode> mode{clock_mode::precise};
+  std::atomic<bool> in_select{false};
+  std::atomic<std::uint32_t> thread{0};
+  std::atomic<std::uint64_t> tok{k_no_token};
+  std::atomic<std::int64_t> tok_ns{0};
+};
+
+}
+
+}
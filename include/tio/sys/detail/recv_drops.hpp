@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include <sys/socket.h>
+
+#include <tio/rx_drops.hpp>
+
+namespace tio::detail {
+
+// recvfrom(2) through recvmsg(2) so the SO_RXQ_OVFL control message comes
+// along. The kernel only attaches it once the socket has dropped something,
+// so a datagram without one counts as zero drops until the first is seen.
+inline auto recv_counting_drops(
+  int fd, std::span<std::byte> buf, sockaddr* from, socklen_t* from_len, rx_drops& drops
+) noexcept -> ssize_t {
+  iovec iov{buf.data(), buf.size()};
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(std::uint32_t))];
+
+  msghdr msg{};
+  msg.msg_name = from;
+  msg.msg_namelen = from_len != nullptr ? *from_len : 0;
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  const ssize_t n = ::recvmsg(fd, &msg, 0);
+  if (n < 0) {
+    return n;
+  }
+  if (from_len != nullptr) {
+    *from_len = msg.msg_namelen;
+  }
+
+  for (auto* c = CMSG_FIRSTHDR(&msg); c != nullptr; c = CMSG_NXTHDR(&msg, c)) {
+    if (c->cmsg_level == SOL_SOCKET && c->cmsg_type == SO_RXQ_OVFL) {
+      std::uint32_t counter = 0;
+      std::memcpy(&counter, CMSG_DATA(c), sizeof(counter));
+      drops.observe(counter);
+      return n;
+    }
+  }
+  drops.observe(drops.counter());
+  return n;
+}
+
+}
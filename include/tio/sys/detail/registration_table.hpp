@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <optional>
+#include <vector>
+
+#include <tio/interest.hpp>
+#include <tio/token.hpp>
+
+namespace tio {
+
+struct registration {
+  int fd;
+  token tok;
+  interest intr;
+};
+
+}
+
+namespace tio::detail {
+
+// Shadow of what is registered with the selector, indexed directly by fd.
+// Stored as two parallel arrays so each fd costs 9 bytes: the token and a
+// state byte holding the interest bits plus a registered flag.
+class registration_table {
+public:
+  [[nodiscard]] auto find(int fd) const noexcept -> std::optional<registration> {
+    if (!contains(fd)) {
+      return std::nullopt;
+    }
+    const auto i = static_cast<std::size_t>(fd);
+    return registration{fd, token{tokens_[i]}, to_interest(states_[i])};
+  }
+
+  [[nodiscard]] auto contains(int fd) const noexcept -> bool {
+    return fd >= 0 && static_cast<std::size_t>(fd) < states_.size() &&
+           (states_[static_cast<std::size_t>(fd)] & k_registered) != 0;
+  }
+
+  [[nodiscard]] auto matches(int fd, token tok, interest intr) const noexcept -> bool {
+    if (!contains(fd)) {
+      return false;
+    }
+    const auto i = static_cast<std::size_t>(fd);
+    return tokens_[i] == tok.value() && states_[i] == (intr.raw() | k_registered);
+  }
+
+  void insert(int fd, token tok, interest intr) {
+    const auto i = static_cast<std::size_t>(fd);
+    if (i >= states_.size()) {
+      const auto grown = std::max(i + 1, states_.size() * 2);
+      tokens_.resize(grown, 0);
+      states_.resize(grown, 0);
+    }
+    if ((states_[i] & k_registered) == 0) {
+      ++len_;
+    }
+    tokens_[i] = tok.value();
+    states_[i] = static_cast<std::uint8_t>(intr.raw() | k_registered);
+  }
+
+  void erase(int fd) noexcept {
+    if (contains(fd)) {
+      states_[static_cast<std::size_t>(fd)] = 0;
+      --len_;
+    }
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return len_; }
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return states_.size(); }
+
+  [[nodiscard]] auto elided() const noexcept -> std::size_t { return elided_; }
+
+  void note_elided() noexcept { ++elided_; }
+
+  template <typename fn_t>
+  void for_each(fn_t&& fn) const {
+    for (std::size_t i = 0; i < states_.size(); ++i) {
+      if ((states_[i] & k_registered) != 0) {
+        fn(registration{static_cast<int>(i), token{tokens_[i]}, to_interest(states_[i])});
+      }
+    }
+  }
+
+private:
+  static constexpr std::uint8_t k_registered = 0x80;
+
+  [[nodiscard]] static constexpr auto to_interest(std::uint8_t state) noexcept -> interest {
+    interest intr{};
+    if ((state & interest::readable().raw()) != 0) {
+      intr |= interest::readable();
+    }
+    if ((state & interest::writable().raw()) != 0) {
+      intr |= interest::writable();
+    }
+    if ((state & interest::priority().raw()) != 0) {
+      intr |= interest::priority();
+    }
+    return intr;
+  }
+
+  std::vector<std::uint64_t> tokens_;
+  std::vector<std::uint8_t> states_;
+  std::size_t len_ = 0;
+  std::size_t elided_ = 0;
+};
+
+}
+
+template <> struct std::formatter<tio::registration> {
+  static constexpr auto parse(std::format_parse_context& ctx) { return ctx.begin(); }
+
+  static auto format(const tio::registration& r, std::format_context& ctx) {
+    return std::format_to(ctx.out(), "registration(fd={}, {}, {})", r.fd, r.tok, r.intr);
+  }
+};
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace tio::detail {
+
+// Bounded single-producer single-consumer ring. Each side keeps a cached
+// copy of the other side's index and only reloads it when the cache says
+// the ring is full (producer) or empty (consumer).
+template <typename t_t>
+class spsc_ring {
+public:
+  explicit spsc_ring(std::size_t capacity) {
+    std::size_t cap = 1;
+    while (cap < capacity) {
+      cap <<= 1;
+    }
+    mask_ = cap - 1;
+    slots_ = std::make_unique<slot[]>(cap);
+  }
+
+  spsc_ring(const spsc_ring&) = delete;
+  auto operator=(const spsc_ring&) -> spsc_ring& = delete;
+
+  ~spsc_ring() {
+    while (try_pop().has_value()) {
+    }
+  }
+
+  // Producer only. Leaves `v` untouched and returns false when full.
+  [[nodiscard]] auto try_push(t_t& v) -> bool {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ > mask_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ > mask_) {
+        return false;
+      }
+    }
+    ::new (slots_[tail & mask_].storage) t_t(std::move(v));
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only.
+  [[nodiscard]] auto try_pop() -> std::optional<t_t> {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return std::nullopt;
+      }
+    }
+    auto* p = std::launder(reinterpret_cast<t_t*>(slots_[head & mask_].storage));
+    std::optional<t_t> v{std::move(*p)};
+    p->~t_t();
+    head_.store(head + 1, std::memory_order_release);
+    return v;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t { return mask_ + 1; }
+
+private:
+  struct slot {
+    alignas(t_t) std::byte storage[sizeof(t_t)];
+  };
+
+  std::size_t mask_ = 0;
+  std::unique_ptr<slot[]> slots_;
+
+  alignas(64) std::atomic<std::size_t> head_{0};
+  std::size_t tail_cache_ = 0;
+
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  std::size_t head_cache_ = 0;
+};
+
+}
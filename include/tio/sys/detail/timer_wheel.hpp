@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tio::detail {
+
+struct wheel_node {
+  wheel_node* prev = nullptr;
+  wheel_node* next = nullptr;
+  std::uint64_t expiry = 0;
+  bool linked = false;
+};
+
+// Hashed timer wheel over abstract ticks. Scheduling and cancelling are
+// O(1); `advance` visits one bucket per elapsed tick (at most one full turn)
+// and skips nodes whose expiry is a later lap. Nodes are intrusive, so the
+// wheel never allocates after construction.
+class timer_wheel {
+public:
+  explicit timer_wheel(std::size_t slots = 512) {
+    std::size_t n = 1;
+    while (n < slots) {
+      n <<= 1;
+    }
+    buckets_.resize(n);
+    mask_ = n - 1;
+  }
+
+  timer_wheel(const timer_wheel&) = delete;
+  auto operator=(const timer_wheel&) -> timer_wheel& = delete;
+
+  // Expiry is clamped to the next tick so a node never lands in a bucket
+  // that has already been visited.
+  void schedule(wheel_node* n, std::uint64_t expiry) noexcept {
+    if (n->linked) {
+      cancel(n);
+    }
+    n->expiry = expiry > now_ ? expiry : now_ + 1;
+
+    const auto at = visit_tick(n->expiry);
+    if (size_ == 0 || (next_ != 0 && at < next_)) {
+      next_ = at;
+    }
+    auto& head = buckets_[n->expiry & mask_];
+    n->prev = nullptr;
+    n->next = head;
+    if (head != nullptr) {
+      head->prev = n;
+    }
+    head = n;
+    n->linked = true;
+    ++size_;
+  }
+
+  void cancel(wheel_node* n) noexcept {
+    if (!n->linked) {
+      return;
+    }
+    if (n->prev != nullptr) {
+      n->prev->next = n->next;
+    } else {
+      buckets_[n->expiry & mask_] = n->next;
+      // Emptied the cached bucket; `advance` handles the ones it fires.
+      if (n->next == nullptr && n->expiry > now_ && visit_tick(n->expiry) == next_) {
+        next_ = 0;
+      }
+    }
+    if (n->next != nullptr) {
+      n->next->prev = n->prev;
+    }
+    n->prev = nullptr;
+    n->next = nullptr;
+    n->linked = false;
+    --size_;
+  }
+
+  // Moves the wheel to `tick` and calls `fn(node*)` for each node whose
+  // expiry has passed. `fn` may reschedule the node it is given; it must
+  // not cancel other nodes.
+  template <typename fn_t>
+  auto advance(std::uint64_t tick, fn_t&& fn) -> std::size_t {
+    if (tick <= now_) {
+      return 0;
+    }
+
+    std::size_t fired = 0;
+    const auto turns = tick - now_;
+    const auto steps = turns > buckets_.size() ? buckets_.size() : turns;
+    const auto first = tick - steps + 1;
+    now_ = tick;
+
+    for (auto t = first; t <= tick; ++t) {
+      wheel_node* n = buckets_[t & mask_];
+      while (n != nullptr) {
+        wheel_node* next = n->next;
+        if (n->expiry <= tick) {
+          cancel(n);
+          fn(n);
+          ++fired;
+        }
+        n = next;
+      }
+    }
+    if (next_ <= tick) {
+      next_ = 0;
+    }
+    return fired;
+  }
+
+  // Ticks until the first non-empty bucket, i.e. the earliest possible
+  // expiry. Cached; only rescans (at most one turn) after that bucket was
+  // emptied or passed.
+  [[nodiscard]] auto ticks_to_next() const noexcept -> std::uint64_t {
+    if (size_ == 0) {
+      return 0;
+    }
+    if (next_ == 0) {
+      next_ = now_ + buckets_.size();
+      for (std::uint64_t d = 1; d <= buckets_.size(); ++d) {
+        if (buckets_[(now_ + d) & mask_] != nullptr) {
+          next_ = now_ + d;
+          break;
+        }
+      }
+    }
+    return next_ - now_;
+  }
+
+  [[nodiscard]] auto now() const noexcept -> std::uint64_t { return now_; }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+
+  [[nodiscard]] auto slots() const noexcept -> std::size_t { return buckets_.size(); }
+
+private:
+  // Tick in (now_, now_ + slots] at which `advance` visits the bucket of
+  // `expiry`, which must be later than now_.
+  [[nodiscard]] auto visit_tick(std::uint64_t expiry) const noexcept -> std::uint64_t {
+    return now_ + ((expiry - now_ - 1) & mask_) + 1;
+  }
+
+  std::vector<wheel_node*> buckets_;
+  std::size_t mask_ = 0;
+  std::uint64_t now_ = 0;
+  std::size_t size_ = 0;
+  // Tick of the first non-empty bucket, or 0 when unknown. Ticks past
+  // now_ are never 0, so it doubles as the dirty flag.
+  mutable std::uint64_t next_ = 0;
+};
+
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+// USDT probes under provider `tio`, compiled in with -DTIO_ENABLE_USDT=ON.
+// An enabled probe is a single nop plus an ELF note describing where its
+// arguments live; bpftrace/perf patch the nop only while attached. When the
+// option is off the macros expand to nothing and their arguments are not
+// evaluated, so arguments must not have side effects.
+//
+//   poll_enter(epfd, timeout_ms, max_events)     poll_exit(epfd, n, errno)
+//   register(fd, token, interest, errno)         reregister(fd, token, interest, errno)
+//   deregister(fd, errno)                        accept(listen_fd, fd, errno)
+//   read(fd, bytes, errno)                       write(fd, bytes, errno)
+//   recv(fd, bytes, errno)                       send(fd, bytes, errno)
+//
+// `errno` is 0 on success; `bytes` is 0 on failure.
+
+#if defined(TIO_USDT)
+
+#include <sys/sdt.h>
+
+#define TIO_PROBE2(name, a1, a2) STAP_PROBE2(tio, name, a1, a2)
+#define TIO_PROBE3(name, a1, a2, a3) STAP_PROBE3(tio, name, a1, a2, a3)
+#define TIO_PROBE4(name, a1, a2, a3, a4) STAP_PROBE4(tio, name, a1, a2, a3, a4)
+
+#else
+
+#define TIO_PROBE2(name, a1, a2) ((void)0)
+#define TIO_PROBE3(name, a1, a2, a3) ((void)0)
+#define TIO_PROBE4(name, a1, a2, a3, a4) ((void)0)
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace tio::detail {
+
+// Chase-Lev work-stealing deque (Lê et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models"), with the two seq_cst fences folded
+// into seq_cst accesses on top/bottom. The owning thread pushes and pops
+// at the bottom; any thread may steal from the top. Rings only grow, and
+// outgrown rings are kept until destruction because a thief may still be
+// reading from one.
+template <typename t_t>
+  requires std::is_pointer_v<t_t>
+class work_deque {
+public:
+  explicit work_deque(std::size_t capacity = 256) {
+    std::size_t cap = 1;
+    while (cap < capacity) {
+      cap <<= 1;
+    }
+    rings_.push_back(std::make_unique<ring>(cap));
+    ring_.store(rings_.back().get(), std::memory_order_relaxed);
+  }
+
+  work_deque(const work_deque&) = delete;
+  auto operator=(const work_deque&) -> work_deque& = delete;
+
+  // Owner only.
+  void push(t_t v) {
+    const auto b = bottom_.load(std::memory_order_relaxed);
+    const auto t = top_.load(std::memory_order_acquire);
+    ring* r = ring_.load(std::memory_order_relaxed);
+
+    if (b - t > static_cast<std::int64_t>(r->mask)) {
+      r = grow(r, t, b);
+    }
+    r->put(b, v);
+    bottom_.store(b + 1, std::memory_order_release);
+  }
+
+  // Owner only. Returns nullptr when empty.
+  [[nodiscard]] auto pop() noexcept -> t_t {
+    const auto b = bottom_.load(std::memory_order_relaxed) - 1;
+    ring* r = ring_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_seq_cst);
+    auto t = top_.load(std::memory_order_seq_cst);
+
+    if (t > b) {
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    t_t v = r->get(b);
+    if (t == b) {
+      if (!top_.compare_exchange_strong(
+            t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+          )) {
+        v = nullptr;
+      }
+      bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+    return v;
+  }
+
+  // Any thread. Returns nullptr when empty or when another thread won the
+  // race for the top element.
+  [[nodiscard]] auto steal() noexcept -> t_t {
+    auto t = top_.load(std::memory_order_seq_cst);
+    const auto b = bottom_.load(std::memory_order_seq_cst);
+
+    if (t >= b) {
+      return nullptr;
+    }
+
+    ring* r = ring_.load(std::memory_order_acquire);
+    t_t v = r->get(t);
+    if (!top_.compare_exchange_strong(
+          t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed
+        )) {
+      return nullptr;
+    }
+    return v;
+  }
+
+  // Approximate when read from a thread other than the owner.
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    const auto b = bottom_.load(std::memory_order_relaxed);
+    const auto t = top_.load(std::memory_order_relaxed);
+    return b > t ? static_cast<std::size_t>(b - t) : 0;
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+  [[nodiscard]] auto capacity() const noexcept -> std::size_t {
+    return ring_.load(std::memory_order_relaxed)->mask + 1;
+  }
+
+private:
+  struct ring {
+    explicit ring(std::size_t cap) : mask{cap - 1}, slots{std::make_unique<std::atomic<t_t>[]>(cap)} {}
+
+    [[nodiscard]] auto get(std::int64_t i) const noexcept -> t_t {
+      return slots[static_cast<std::size_t>(i) & mask].load(std::memory_order_relaxed);
+    }
+
+    void put(std::int64_t i, t_t v) noexcept {
+      slots[static_cast<std::size_t>(i) & mask].store(v, std::memory_order_relaxed);
+    }
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<t_t>[]> slots;
+  };
+
+  auto grow(ring* old, std::int64_t t, std::int64_t b) -> ring* {
+    rings_.push_back(std::make_unique<ring>((old->mask + 1) * 2));
+    ring* r = rings_.back().get();
+    for (auto i = t; i < b; ++i) {
+      r->put(i, old->get(i));
+    }
+    ring_.store(r, std::memory_order_release);
+    return r;
+  }
+
+  alignas(64) std::atomic<std::int64_t> top_{0};
+  alignas(64) std::atomic<std::int64_t> bottom_{0};
+  std::atomic<ring*> ring_{nullptr};
+  std::vector<std::unique_ptr<ring>> rings_;
+};
+
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace tio::sys::unix {
+
+// Blocks while `word` still holds `expected`. Spurious returns are allowed;
+// callers re-check their condition.
+void futex_wait(const std::atomic<std::uint32_t>& word, std::uint32_t expected) noexcept;
+
+// Wakes up to `count` threads blocked in futex_wait on `word`.
+void futex_wake(const std::atomic<std::uint32_t>& word, int count) noexcept;
+
+}
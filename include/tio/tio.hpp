@@ -11,27 +11,50 @@
 
 #pragma once
 
+#include <tio/clock.hpp>
 #include <tio/error.hpp>
 #include <tio/interest.hpp>
 #include <tio/token.hpp>
 
+#include <tio/dispatch.hpp>
 #include <tio/event.hpp>
+#include <tio/flight_recorder.hpp>
+#include <tio/flush.hpp>
+#include <tio/histogram.hpp>
+#include <tio/io_counters.hpp>
+#include <tio/metrics.hpp>
 #include <tio/poll.hpp>
+#include <tio/rx_drops.hpp>
 #include <tio/source.hpp>
+#include <tio/stats.hpp>
 
 #include <tio/waker.hpp>
+#include <tio/watchdog.hpp>
+#include <tio/work_pool.hpp>
 
 #include <tio/raw_fd.hpp>
 
 #include <tio/net/tcp_listener.hpp>
 #include <tio/net/tcp_stream.hpp>
 #include <tio/net/udp_socket.hpp>
+#include <tio/net/acceptor.hpp>
+#include <tio/net/connection_manager.hpp>
+#include <tio/net/listen_monitor.hpp>
 
 #include <tio/unix/unix_listener.hpp>
 #include <tio/unix/unix_stream.hpp>
 #include <tio/unix/unix_datagram.hpp>
 #include <tio/unix/pipe.hpp>
 
+#include <tio/coro/async_source.hpp>
+#include <tio/coro/reactor.hpp>
+#include <tio/coro/task.hpp>
+
+#include <tio/exec/algorithms.hpp>
+#include <tio/exec/io.hpp>
+#include <tio/exec/scheduler.hpp>
+#include <tio/exec/sender.hpp>
+
 #include <tio/sys/detail/fd_guard.hpp>
 #include <tio/sys/detail/socket_addr.hpp>
 #include <tio/sys/detail/unix_addr.hpp>
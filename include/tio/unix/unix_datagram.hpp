@@ -18,6 +18,7 @@
 #include <tio/error.hpp>
 #include <tio/interest.hpp>
 #include <tio/poll.hpp>
+#include <tio/rx_drops.hpp>
 #include <tio/source.hpp>
 #include <tio/sys/detail/fd_guard.hpp>
 #include <tio/sys/detail/unix_addr.hpp>
@@ -55,12 +56,26 @@ public:
 
   [[nodiscard]] auto recv(std::span<std::byte> buf) const -> result<std::size_t>;
 
+  // Like `recv_from` / `recv`, and feeds the SO_RXQ_OVFL drop counter into
+  // `drops` once `set_rxq_overflow(true)` is on. Unix datagram senders get
+  // EAGAIN when the receiver is full rather than having datagrams dropped,
+  // so the count normally stays zero; it is here so code can treat both
+  // datagram sockets alike.
+  [[nodiscard]] auto recv_from(std::span<std::byte> buf, rx_drops& drops) const
+      -> result<std::pair<std::size_t, detail::unix_addr>>;
+
+  [[nodiscard]] auto recv(std::span<std::byte> buf, rx_drops& drops) const -> result<std::size_t>;
+
   [[nodiscard]] auto peer_addr() const -> result<detail::unix_addr>;
 
   [[nodiscard]] auto local_addr() const -> result<detail::unix_addr>;
 
   [[nodiscard]] auto shutdown(int how) const -> void_result;
 
+  [[nodiscard]] auto set_rxq_overflow(bool enable) const -> void_result;
+
+  [[nodiscard]] auto rxq_overflow() const -> result<bool>;
+
   [[nodiscard]] auto take_error() const -> result<error>;
 
   [[nodiscard]] auto raw_fd() const noexcept -> int { return fd_.raw_fd(); }
@@ -19,6 +19,7 @@
 
 #include <tio/error.hpp>
 #include <tio/interest.hpp>
+#include <tio/io_counters.hpp>
 #include <tio/poll.hpp>
 #include <tio/source.hpp>
 #include <tio/sys/detail/fd_guard.hpp>
@@ -63,6 +64,23 @@ public:
 
   [[nodiscard]] auto write_vectored(std::span<const iovec> bufs) const -> result<std::size_t>;
 
+  // Same calls, also recorded in the connection's `io_counters`.
+  [[nodiscard]] auto read(std::span<std::byte> buf, io_counters& c) const -> result<std::size_t> {
+    return c.count_read(read(buf));
+  }
+
+  [[nodiscard]] auto write(std::span<const std::byte> buf, io_counters& c) const -> result<std::size_t> {
+    return c.count_write(write(buf), buf.size());
+  }
+
+  [[nodiscard]] auto read_vectored(std::span<iovec> bufs, io_counters& c) const -> result<std::size_t> {
+    return c.count_read(read_vectored(bufs));
+  }
+
+  [[nodiscard]] auto write_vectored(std::span<const iovec> bufs, io_counters& c) const -> result<std::size_t> {
+    return c.count_write(write_vectored(bufs), detail::iov_bytes(bufs));
+  }
+
   [[nodiscard]] auto raw_fd() const noexcept -> int { return fd_.raw_fd(); }
 
   auto into_raw_fd() noexcept -> int { return fd_.release(); }
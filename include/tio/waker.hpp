@@ -11,10 +11,13 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 
 #include <tio/error.hpp>
+#include <tio/flight_recorder.hpp>
 #include <tio/poll.hpp>
+#include <tio/stats.hpp>
 #include <tio/sys/unix_/eventfd_waker.hpp>
 #include <tio/token.hpp>
 
@@ -24,15 +27,37 @@ class waker {
 public:
   [[nodiscard]] static auto create(registry reg, token tok) -> result<waker>;
 
-  [[nodiscard]] auto wake() const noexcept -> void_result { return inner_->waker_.wake(); }
+  [[nodiscard]] auto wake() const noexcept -> void_result {
+    if (inner_->stats_ != nullptr) {
+      inner_->stats_->wakes.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (auto* rec = inner_->recorder_.get(); rec != nullptr) {
+      rec->record(flight_event::wake, rec->now(), loop_clock::duration::zero(), inner_->tok_.value(), 0);
+    }
+    return inner_->waker_.wake();
+  }
 
-  void drain() const noexcept { inner_->waker_.drain(); }
+  void drain() const noexcept {
+    if (inner_->stats_ != nullptr) {
+      inner_->stats_->drains.fetch_add(1, std::memory_order_relaxed);
+    }
+    inner_->waker_.drain();
+  }
 
 private:
   struct inner {
     sys::unix::eventfd_waker waker_;
+    std::shared_ptr<detail::poll_counters> stats_;
+    std::shared_ptr<flight_recorder> recorder_;
+    token tok_;
 
-    explicit inner(sys::unix::eventfd_waker w) noexcept : waker_{std::move(w)} {}
+    inner(
+      sys::unix::eventfd_waker w,
+      std::shared_ptr<detail::poll_counters> stats,
+      std::shared_ptr<flight_recorder> recorder,
+      token tok
+    ) noexcept
+      : waker_{std::move(w)}, stats_{std::move(stats)}, recorder_{std::move(recorder)}, tok_{tok} {}
   };
 
   explicit waker(std::shared_ptr<inner> p) noexcept : inner_{std::move(p)} {}
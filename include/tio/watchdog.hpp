@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include <tio/error.hpp>
+#include <tio/flight_recorder.hpp>
+#include <tio/poll.hpp>
+#include <tio/token.hpp>
+
+namespace tio {
+
+namespace detail {
+
+struct watchdog_state;
+
+}
+
+// One stalled loop iteration: the poll returned from its selector wait
+// `stalled_for` ago and has not come back. `tok` is the token last named
+// with `poll::mark_dispatch`, running for `tok_for`. `recorder` is the
+// poll's flight recorder, if any, so the callback can dump it.
+struct stall_report {
+  std::uint32_t thread = 0;
+  std::uint64_t iteration = 0;
+  std::chrono::nanoseconds stalled_for{0};
+  std::optional<token> tok;
+  std::chrono::nanoseconds tok_for{0};
+  flight_recorder* recorder = nullptr;
+};
+
+struct watchdog_options {
+  // A loop counts as stalled once it has been out of its selector wait
+  // this long. Checked every `interval`, so reports lag by up to that.
+  std::chrono::milliseconds threshold{100};
+  std::chrono::milliseconds interval{10};
+
+  // When non-zero, the stalled thread is sent this signal (tgkill) right
+  // after `on_stall` runs, e.g. SIGPROF with a handler that captures a
+  // stack trace. The application installs the handler.
+  int signal = 0;
+
+  // Runs on the watchdog thread, once per stalled iteration.
+  std::function<void(const stall_report&)> on_stall;
+};
+
+// Background thread that watches the heartbeat every poll keeps and
+// reports iterations that stay out of `select` longer than the threshold,
+// which is what a handler blocking the loop looks like.
+class watchdog {
+public:
+  [[nodiscard]] static auto create(watchdog_options opts) -> result<watchdog>;
+
+  watchdog(watchdog&&) noexcept;
+  auto operator=(watchdog&&) noexcept -> watchdog&;
+
+  watchdog(const watchdog&) = delete;
+  auto operator=(const watchdog&) -> watchdog& = delete;
+
+  // Stops and joins the thread.
+  ~watchdog();
+
+  // Starts watching the poll behind `reg`. The watchdog holds no
+  // ownership: a poll that is destroyed is dropped on the next check.
+  // Watching the same poll twice is a no-op.
+  [[nodiscard]] auto watch(const registry& reg) -> void_result;
+
+  // Stops watching the poll behind `reg`; call it when its loop finishes
+  // but the poll lives on, or the idle loop is reported as a stall. A
+  // report already being delivered may still arrive. ENOENT if not watched.
+  [[nodiscard]] auto unwatch(const registry& reg) -> void_result;
+
+  [[nodiscard]] auto stall_count() const noexcept -> std::uint64_t;
+
+private:
+  explicit watchdog(std::unique_ptr<detail::watchdog_state> state) noexcept;
+
+  std::unique_ptr<detail::watchdog_state> state_;
+};
+
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <tio/error.hpp>
+#include <tio/poll.hpp>
+#include <tio/token.hpp>
+#include <tio/waker.hpp>
+
+namespace tio {
+
+namespace detail {
+
+class completion_inbox;
+struct pool_state;
+
+}
+
+// Intrusive unit of CPU work. `run` executes on a pool worker; if the item
+// was submitted with a completion queue, `complete` later runs on the
+// thread that drains that queue. The item must stay alive until then.
+struct work_item {
+  void (*run)(work_item* self) noexcept;
+  void (*complete)(work_item* self) noexcept = nullptr;
+  work_item* next = nullptr;
+  detail::completion_inbox* home = nullptr;
+};
+
+namespace detail {
+
+// Lock-free MPSC list of finished items. Only a push onto an empty list
+// wakes the poll, so a burst of completions costs one eventfd write.
+class completion_inbox {
+public:
+  explicit completion_inbox(waker w) noexcept : wake_{std::move(w)} {}
+
+  void push(work_item* item) noexcept;
+
+  auto drain() noexcept -> std::size_t;
+
+  [[nodiscard]] auto wake_count() const noexcept -> std::uint64_t {
+    return wakes_.load(std::memory_order_relaxed);
+  }
+
+private:
+  waker wake_;
+  std::atomic<work_item*> head_{nullptr};
+  std::atomic<std::uint64_t> wakes_{0};
+};
+
+template <typename work_fn_t, typename done_fn_t>
+struct closure_item final : work_item {
+  using value_type = std::invoke_result_t<work_fn_t&>;
+  using slot_type = std::conditional_t<std::is_void_v<value_type>, bool, value_type>;
+
+  closure_item(work_fn_t work, done_fn_t done)
+    : work_item{&closure_item::run_fn, &closure_item::complete_fn}, work_{std::move(work)},
+      done_{std::move(done)} {}
+
+  static void run_fn(work_item* self) noexcept {
+    auto* c = static_cast<closure_item*>(self);
+    if constexpr (std::is_void_v<value_type>) {
+      c->work_();
+      c->value_.emplace(true);
+    } else {
+      c->value_.emplace(c->work_());
+    }
+  }
+
+  static void complete_fn(work_item* self) noexcept {
+    std::unique_ptr<closure_item> c{static_cast<closure_item*>(self)};
+    if constexpr (std::is_void_v<value_type>) {
+      c->done_();
+    } else {
+      c->done_(std::move(*c->value_));
+    }
+  }
+
+  work_fn_t work_;
+  done_fn_t done_;
+  std::optional<slot_type> value_;
+};
+
+}
+
+// Completion channel back into a poll. Register it once per loop, then call
+// `drain()` whenever an event carrying its token is returned.
+class completion_queue {
+public:
+  [[nodiscard]] static auto create(registry reg, token tok) -> result<completion_queue>;
+
+  // Runs `complete` for every finished item in completion order and
+  // returns how many ran.
+  auto drain() noexcept -> std::size_t { return inbox_->drain(); }
+
+  [[nodiscard]] auto wake_count() const noexcept -> std::uint64_t { return inbox_->wake_count(); }
+
+private:
+  friend class work_pool;
+
+  explicit completion_queue(std::unique_ptr<detail::completion_inbox> inbox) noexcept
+    : inbox_{std::move(inbox)} {}
+
+  std::unique_ptr<detail::completion_inbox> inbox_;
+};
+
+// Work-stealing CPU pool. Each worker owns a Chase-Lev deque; submissions
+// from a worker go to its own deque, everything else through a shared
+// injector. Idle workers spin briefly, then park on a futex.
+class work_pool {
+public:
+  [[nodiscard]] static auto create(std::size_t threads) -> result<work_pool>;
+
+  work_pool(work_pool&&) noexcept;
+  auto operator=(work_pool&&) noexcept -> work_pool&;
+
+  work_pool(const work_pool&) = delete;
+  auto operator=(const work_pool&) -> work_pool& = delete;
+
+  // Finishes all queued work, then joins the workers.
+  ~work_pool();
+
+  // Fire-and-forget: the pool does not touch `item` after `run` returns.
+  void submit(work_item* item);
+
+  void submit(work_item* item, completion_queue& cq);
+
+  // Runs `work()` on the pool, then `done(result)` on the thread draining
+  // `cq`. Allocates one node per call.
+  template <typename work_fn_t, typename done_fn_t>
+  void submit(completion_queue& cq, work_fn_t work, done_fn_t done) {
+    using item_t = detail::closure_item<work_fn_t, done_fn_t>;
+    submit(new item_t{std::move(work), std::move(done)}, cq);
+  }
+
+  [[nodiscard]] auto thread_count() const noexcept -> std::size_t;
+
+  [[nodiscard]] auto steal_count() const noexcept -> std::uint64_t;
+
+  [[nodiscard]] auto park_count() const noexcept -> std::uint64_t;
+
+private:
+  explicit work_pool(std::unique_ptr<detail::pool_state> state) noexcept;
+
+  void enqueue(work_item* item);
+
+  std::unique_ptr<detail::pool_state> state_;
+};
+
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <new>
+
+#include <tio/coro/frame_pool.hpp>
+
+namespace tio::coro::detail {
+
+frame_pool::~frame_pool() {
+  for (std::size_t cls = 0; cls < k_classes; ++cls) {
+    while (free_block* b = free_[cls]) {
+      free_[cls] = b->next;
+      ::operator delete(b, k_min_class << cls);
+    }
+  }
+}
+
+auto frame_pool::local() noexcept -> frame_pool& {
+  thread_local frame_pool pool;
+  return pool;
+}
+
+auto frame_pool::allocate(const std::size_t size) -> void* {
+  if (size > k_max_block) {
+    return ::operator new(size);
+  }
+
+  const auto cls = class_of(size);
+  if (free_block* b = free_[cls]) {
+    free_[cls] = b->next;
+    --cached_;
+    return b;
+  }
+
+  ++allocated_;
+  return ::operator new(k_min_class << cls);
+}
+
+void frame_pool::deallocate(void* p, const std::size_t size) noexcept {
+  if (size > k_max_block) {
+    ::operator delete(p, size);
+    return;
+  }
+
+  const auto cls = class_of(size);
+  auto* b = static_cast<free_block*>(p);
+  b->next = free_[cls];
+  free_[cls] = b;
+  ++cached_;
+}
+
+}
@@ -0,0 +1,324 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+
+#include <tio/coro/reactor.hpp>
+
+namespace tio::coro {
+
+namespace detail {
+
+void reactor_core::retire(io_state* st) noexcept {
+  st->retired = true;
+
+  // Parked waiters are finished from the loop rather than from inside the
+  // source's destructor, so they never run on a half-destroyed owner.
+  for (waiter* w : {std::exchange(st->reader, nullptr), std::exchange(st->writer, nullptr)}) {
+    if (w != nullptr) {
+      w->next_cancelled = cancelled;
+      cancelled = w;
+    }
+  }
+
+  if (!dispatching) {
+    delete st;
+    return;
+  }
+  st->next_retired = retired;
+  retired = st;
+}
+
+void reactor_core::reap() noexcept {
+  while (io_state* st = retired) {
+    retired = st->next_retired;
+    delete st;
+  }
+}
+
+void reactor_core::run_cancelled() noexcept {
+  while (waiter* w = cancelled) {
+    cancelled = w->next_cancelled;
+    w->cancel(w);
+  }
+}
+
+void reactor_core::dispatch(const event& ev) noexcept {
+  if (ev.tok() == k_waker_token) {
+    wake.drain();
+    return;
+  }
+
+  auto* st = reinterpret_cast<io_state*>(ev.tok().value());
+  if (st->retired) {
+    return;
+  }
+
+  const bool hangup = ev.is_error() || ev.is_read_closed();
+
+  if (st->reader != nullptr && (ev.is_readable() || hangup)) {
+    waiter* w = std::exchange(st->reader, nullptr);
+    w->complete(w);
+  }
+
+  if (st->retired) {
+    return;
+  }
+
+  if (st->writer != nullptr && (ev.is_writable() || ev.is_write_closed() || hangup)) {
+    waiter* w = std::exchange(st->writer, nullptr);
+    w->complete(w);
+  }
+}
+
+void reactor_core::post(task_node* n) noexcept {
+  n->next = nullptr;
+  bool was_empty = false;
+  {
+    const std::lock_guard lock{posted_mu};
+    was_empty = posted_head == nullptr;
+    if (was_empty) {
+      posted_head = n;
+    } else {
+      posted_tail->next = n;
+    }
+    posted_tail = n;
+    has_posted.store(true, std::memory_order_release);
+  }
+
+  if (was_empty && !on_loop_thread()) {
+    [[maybe_unused]] auto r = wake.wake();
+  }
+}
+
+void reactor_core::run_posted() noexcept {
+  if (!has_posted.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  task_node* head = nullptr;
+  {
+    const std::lock_guard lock{posted_mu};
+    head = std::exchange(posted_head, nullptr);
+    posted_tail = nullptr;
+    has_posted.store(false, std::memory_order_relaxed);
+  }
+
+  while (head != nullptr) {
+    task_node* n = head;
+    head = n->next;
+    n->run(n);
+  }
+}
+
+namespace {
+
+auto timer_before(const timer_node* a, const timer_node* b) noexcept -> bool {
+  return a->deadline < b->deadline;
+}
+
+void sift_up(std::vector<timer_node*>& heap, std::size_t i) noexcept {
+  while (i > 0) {
+    const auto parent = (i - 1) / 2;
+    if (!timer_before(heap[i], heap[parent])) {
+      break;
+    }
+    std::swap(heap[i], heap[parent]);
+    heap[i]->heap_index = i;
+    heap[parent]->heap_index = parent;
+    i = parent;
+  }
+}
+
+void sift_down(std::vector<timer_node*>& heap, std::size_t i) noexcept {
+  const auto n = heap.size();
+  while (true) {
+    auto smallest = i;
+    const auto l = 2 * i + 1;
+    const auto r = l + 1;
+    if (l < n && timer_before(heap[l], heap[smallest])) {
+      smallest = l;
+    }
+    if (r < n && timer_before(heap[r], heap[smallest])) {
+      smallest = r;
+    }
+    if (smallest == i) {
+      break;
+    }
+    std::swap(heap[i], heap[smallest]);
+    heap[i]->heap_index = i;
+    heap[smallest]->heap_index = smallest;
+    i = smallest;
+  }
+}
+
+}
+
+void reactor_core::add_timer(timer_node* t) {
+  t->heap_index = timers.size();
+  timers.push_back(t);
+  sift_up(timers, t->heap_index);
+}
+
+void reactor_core::remove_timer(timer_node* t) noexcept {
+  const auto i = t->heap_index;
+  if (i == timer_node::k_unqueued) {
+    return;
+  }
+
+  t->heap_index = timer_node::k_unqueued;
+  timer_node* last = timers.back();
+  timers.pop_back();
+  if (last == t) {
+    return;
+  }
+
+  timers[i] = last;
+  last->heap_index = i;
+  sift_down(timers, i);
+  sift_up(timers, last->heap_index);
+}
+
+void reactor_core::fire_timers(const loop_clock::time_point now) noexcept {
+  while (!timers.empty() && timers.front()->deadline <= now) {
+    timer_node* t = timers.front();
+    remove_timer(t);
+    t->fire(t);
+  }
+}
+
+void reactor_core::track_cancel(cancel_node* c) noexcept {
+  c->prev = nullptr;
+  c->next = cancellable;
+  if (cancellable != nullptr) {
+    cancellable->prev = c;
+  }
+  cancellable = c;
+}
+
+void reactor_core::untrack_cancel(cancel_node* c) noexcept {
+  if (c->prev != nullptr) {
+    c->prev->next = c->next;
+  } else if (cancellable == c) {
+    cancellable = c->next;
+  }
+  if (c->next != nullptr) {
+    c->next->prev = c->prev;
+  }
+  c->prev = nullptr;
+  c->next = nullptr;
+}
+
+void reactor_core::request_cancel() noexcept {
+  cancel_pending.store(true, std::memory_order_release);
+  if (!on_loop_thread()) {
+    [[maybe_unused]] auto r = wake.wake();
+  }
+}
+
+void reactor_core::run_cancellations() noexcept {
+  if (!cancel_pending.exchange(false, std::memory_order_acquire)) {
+    return;
+  }
+
+  cancel_node* c = cancellable;
+  while (c != nullptr) {
+    cancel_node* next = c->next;
+    if (c->requested.load(std::memory_order_acquire)) {
+      untrack_cancel(c);
+      c->on_stop(c);
+    }
+    c = next;
+  }
+}
+
+auto reactor_core::next_timeout(const std::optional<std::chrono::milliseconds> timeout) const
+    -> std::optional<std::chrono::milliseconds> {
+  if (has_posted.load(std::memory_order_acquire) ||
+      cancel_pending.load(std::memory_order_acquire) || cancelled != nullptr) {
+    return std::chrono::milliseconds{0};
+  }
+
+  if (timers.empty()) {
+    return timeout;
+  }
+
+  const auto now = loop_clock::sample(poll.clock().mode());
+  const auto until = timers.front()->deadline - now;
+  auto ms = std::chrono::ceil<std::chrono::milliseconds>(until);
+  ms = std::max(ms, std::chrono::milliseconds{0});
+
+  if (timeout.has_value()) {
+    return std::min(ms, *timeout);
+  }
+  return ms;
+}
+
+}
+
+auto reactor::create(const std::size_t event_capacity, const poll_options& opts)
+    -> result<reactor> {
+  auto p = poll::create(opts);
+  if (!p.has_value()) {
+    return std::unexpected{p.error()};
+  }
+
+  auto w = waker::create(p->get_registry(), detail::reactor_core::k_waker_token);
+  if (!w.has_value()) {
+    return std::unexpected{w.error()};
+  }
+
+  return reactor{std::make_unique<detail::reactor_core>(
+    std::move(p.value()), std::move(w.value()), event_capacity
+  )};
+}
+
+void reactor::spawn(task<void> t) {
+  ++core_->live_tasks;
+  detail::run_detached(std::move(t), core_.get());
+}
+
+auto reactor::run_once(const std::optional<std::chrono::milliseconds> timeout) -> void_result {
+  auto& core = *core_;
+  core.owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+  if (auto r = core.poll.do_poll(core.evs, core.next_timeout(timeout)); !r.has_value()) {
+    return r;
+  }
+
+  core.dispatching = true;
+  for (const auto& ev : core.evs) {
+    core.dispatch(ev);
+  }
+  core.run_posted();
+  core.run_cancelled();
+  core.run_cancellations();
+  core.fire_timers(core.poll.loop_now());
+  core.dispatching = false;
+  core.reap();
+
+  return {};
+}
+
+auto reactor::run() -> void_result {
+  core_->stopped = false;
+
+  while (core_->live_tasks > 0 && !core_->stopped) {
+    if (auto r = run_once(std::nullopt); !r.has_value()) {
+      return r;
+    }
+  }
+  return {};
+}
+
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <format>
+#include <iterator>
+#include <ostream>
+#include <string_view>
+
+#include <unistd.h>
+
+#include <tio/flight_recorder.hpp>
+
+namespace tio {
+
+namespace {
+
+auto event_name(flight_event kind) noexcept -> std::string_view {
+  switch (kind) {
+    case flight_event::poll_wait: return "poll_wait";
+    case flight_event::dispatch: return "dispatch";
+    case flight_event::register_fd: return "register";
+    case flight_event::reregister_fd: return "reregister";
+    case flight_event::deregister_fd: return "deregister";
+    case flight_event::wake: return "wake";
+  }
+  return "unknown";
+}
+
+auto micros(std::chrono::nanoseconds d) noexcept -> double {
+  return static_cast<double>(d.count()) / 1000.0;
+}
+
+}
+
+auto flight_recorder::snapshot() const -> std::vector<flight_record> {
+  const auto head = head_.load(std::memory_order_acquire);
+  const auto first = head > capacity() ? head - capacity() : 0;
+
+  std::vector<flight_record> out;
+  out.reserve(static_cast<std::size_t>(head - first));
+  for (auto n = first; n < head; ++n) {
+    constexpr auto r = std::memory_order_relaxed;
+    const auto& s = slots_[n & mask_];
+    const auto seq = s.seq.load(std::memory_order_acquire);
+    if (seq != 2 * n + 2) {
+      continue;  // still being written, or already overwritten
+    }
+
+    flight_record rec;
+    rec.start = loop_clock::time_point{loop_clock::duration{s.start.load(r)}};
+    rec.duration = std::chrono::nanoseconds{s.duration.load(r)};
+    rec.id = s.id.load(r);
+    rec.arg = s.arg.load(r);
+    const auto meta = s.meta.load(r);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s.seq.load(r) != seq) {
+      continue;
+    }
+
+    rec.kind = static_cast<flight_event>(meta & 0xff);
+    rec.interest_bits = static_cast<std::uint8_t>(meta >> 8);
+    rec.err = static_cast<std::uint16_t>(meta >> 16);
+    rec.thread = static_cast<std::uint32_t>(meta >> 32);
+    out.push_back(rec);
+  }
+  return out;
+}
+
+void flight_recorder::write_chrome_trace(std::ostream& out) const {
+  const auto records = snapshot();
+  const auto pid = ::getpid();
+  std::ostreambuf_iterator<char> it{out};
+
+  it = std::format_to(it, "{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  bool first = true;
+  for (const auto& rec : records) {
+    const auto ts = micros(std::chrono::duration_cast<std::chrono::nanoseconds>(rec.start.time_since_epoch()));
+    it = std::format_to(
+      it,
+      "{}\n{{\"name\":\"{}\",\"cat\":\"tio\",\"pid\":{},\"tid\":{},\"ts\":{:.3f},",
+      first ? "" : ",",
+      event_name(rec.kind),
+      pid,
+      rec.thread,
+      ts
+    );
+    first = false;
+
+    switch (rec.kind) {
+      case flight_event::poll_wait:
+        it = std::format_to(
+          it, "\"ph\":\"X\",\"dur\":{:.3f},\"args\":{{\"events\":{}}}}}", micros(rec.duration), rec.arg
+        );
+        break;
+      case flight_event::dispatch:
+        it = std::format_to(
+          it, "\"ph\":\"X\",\"dur\":{:.3f},\"args\":{{\"token\":{}}}}}", micros(rec.duration), rec.id
+        );
+        break;
+      case flight_event::register_fd:
+      case flight_event::reregister_fd:
+        it = std::format_to(
+          it,
+          "\"ph\":\"i\",\"s\":\"t\",\"args\":{{\"fd\":{},\"token\":{},\"interest\":{},\"errno\":{}}}}}",
+          rec.arg,
+          rec.id,
+          static_cast<unsigned>(rec.interest_bits),
+          rec.err
+        );
+        break;
+      case flight_event::deregister_fd:
+        it = std::format_to(
+          it, "\"ph\":\"i\",\"s\":\"t\",\"args\":{{\"fd\":{},\"errno\":{}}}}}", rec.arg, rec.err
+        );
+        break;
+      case flight_event::wake:
+        it = std::format_to(it, "\"ph\":\"i\",\"s\":\"t\",\"args\":{{\"token\":{}}}}}", rec.id);
+        break;
+    }
+  }
+  std::format_to(it, "\n]}}\n");
+}
+
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <tio/flush.hpp>
+
+namespace tio {
+
+namespace {
+
+constexpr std::size_t k_max_iov = 128;
+
+// Consumed segments / arena bytes tolerated before compacting. Compaction
+// also waits until at least half is dead, so its cost stays amortised.
+constexpr std::size_t k_compact_segs = 64;
+constexpr std::size_t k_compact_bytes = 64 * 1024;
+
+}
+
+outbox::~outbox() {
+  if (queue_ != nullptr) {
+    queue_->unmark(*this);
+  }
+}
+
+void outbox::append(const std::span<const std::byte> bytes) {
+  if (bytes.empty()) {
+    return;
+  }
+
+  const auto off = arena_.size();
+  arena_.insert(arena_.end(), bytes.begin(), bytes.end());
+
+  // Adjacent copies coalesce into one iovec.
+  if (segs_.size() > first_ && segs_.back().ref == nullptr &&
+      segs_.back().off + segs_.back().len == off) {
+    segs_.back().len += bytes.size();
+  } else {
+    segs_.push_back(segment{nullptr, off, bytes.size()});
+  }
+  pending_ += bytes.size();
+}
+
+void outbox::append_ref(const std::span<const std::byte> bytes) {
+  if (bytes.empty()) {
+    return;
+  }
+  segs_.push_back(segment{bytes.data(), 0, bytes.size()});
+  pending_ += bytes.size();
+}
+
+auto outbox::write_some(const std::size_t max_bytes) -> result<std::size_t> {
+  if (pending_ == 0 || max_bytes == 0) {
+    return 0;
+  }
+
+  std::array<iovec, k_max_iov> iov{};
+  std::size_t count = 0;
+  std::size_t budget = max_bytes;
+  for (auto i = first_; i < segs_.size() && count < iov.size() && budget > 0; ++i) {
+    const auto& s = segs_[i];
+    const std::byte* base = (s.ref != nullptr ? s.ref : arena_.data()) + s.off;
+    const auto len = std::min(s.len, budget);
+    iov[count++] = iovec{const_cast<std::byte*>(base), len};
+    budget -= len;
+  }
+
+  ssize_t n = -1;
+  if (is_socket_) {
+    msghdr msg{};
+    msg.msg_iov = iov.data();
+    msg.msg_iovlen = count;
+    n = ::sendmsg(fd_, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (n < 0 && errno == ENOTSOCK) {
+      is_socket_ = false;
+    }
+  }
+  if (!is_socket_) {
+    n = ::writev(fd_, iov.data(), static_cast<int>(count));
+  }
+
+  if (n < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  consume(static_cast<std::size_t>(n));
+  return static_cast<std::size_t>(n);
+}
+
+void outbox::consume(std::size_t n) noexcept {
+  pending_ -= n;
+  while (n > 0) {
+    auto& s = segs_[first_];
+    if (n < s.len) {
+      s.off += n;
+      s.len -= n;
+      break;
+    }
+    n -= s.len;
+    ++first_;
+  }
+
+  if (first_ == segs_.size()) {
+    segs_.clear();
+    arena_.clear();
+    first_ = 0;
+    return;
+  }
+  compact();
+}
+
+// A connection that keeps appending while writes stay partial never
+// drains fully, so drop the written prefix of `segs_` and `arena_` here.
+void outbox::compact() noexcept {
+  // Arena bytes are appended in segment order, so the first live arena
+  // segment has the lowest offset and everything before it is written.
+  std::size_t dead = arena_.size();
+  for (auto i = first_; i < segs_.size(); ++i) {
+    if (segs_[i].ref == nullptr) {
+      dead = segs_[i].off;
+      break;
+    }
+  }
+
+  const bool segs_due = first_ >= k_compact_segs && 2 * first_ >= segs_.size();
+  const bool arena_due = dead >= k_compact_bytes && 2 * dead >= arena_.size();
+  if (!segs_due && !arena_due) {
+    return;
+  }
+
+  segs_.erase(segs_.begin(), segs_.begin() + static_cast<std::ptrdiff_t>(first_));
+  first_ = 0;
+  if (dead > 0) {
+    arena_.erase(arena_.begin(), arena_.begin() + static_cast<std::ptrdiff_t>(dead));
+    for (auto& s : segs_) {
+      if (s.ref == nullptr) {
+        s.off -= dead;
+      }
+    }
+  }
+}
+
+flush_queue::~flush_queue() {
+  while (head_ != nullptr) {
+    unmark(*head_);
+  }
+}
+
+void flush_queue::push_back(outbox& o) noexcept {
+  o.queue_ = this;
+  o.prev_ = tail_;
+  o.next_ = nullptr;
+  if (tail_ != nullptr) {
+    tail_->next_ = &o;
+  } else {
+    head_ = &o;
+  }
+  tail_ = &o;
+  ++size_;
+}
+
+void flush_queue::mark(outbox& o) noexcept {
+  if (o.queue_ == this) {
+    return;
+  }
+  if (o.queue_ != nullptr) {
+    o.queue_->unmark(o);
+  }
+  push_back(o);
+}
+
+void flush_queue::unmark(outbox& o) noexcept {
+  if (o.queue_ != this) {
+    return;
+  }
+  if (o.prev_ != nullptr) {
+    o.prev_->next_ = o.next_;
+  } else {
+    head_ = o.next_;
+  }
+  if (o.next_ != nullptr) {
+    o.next_->prev_ = o.prev_;
+  } else {
+    tail_ = o.prev_;
+  }
+  o.queue_ = nullptr;
+  o.prev_ = nullptr;
+  o.next_ = nullptr;
+  --size_;
+}
+
+auto flush_queue::flush() -> std::size_t {
+  std::size_t written = 0;
+
+  // Only what was marked before this call; requeued outboxes wait for the
+  // next flush so one busy connection cannot starve the rest.
+  for (auto n = size_; n > 0 && head_ != nullptr; --n) {
+    outbox& o = *head_;
+    unmark(o);
+    if (o.empty()) {
+      continue;
+    }
+
+    auto r = o.write_some(fair_share_);
+    ++stats_.syscalls;
+    if (!r.has_value()) {
+      if (r.error().is_would_block()) {
+        ++stats_.would_block;
+      } else {
+        ++stats_.errors;
+        o.error_ = r.error();
+      }
+      continue;
+    }
+
+    stats_.bytes += *r;
+    ++written;
+    if (!o.empty()) {
+      push_back(o);
+    }
+  }
+  return written;
+}
+
+}
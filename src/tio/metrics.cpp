@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <tio/clock.hpp>
+#include <tio/metrics.hpp>
+#include <tio/sys/detail/fd_guard.hpp>
+
+namespace tio {
+
+namespace {
+
+using layout = detail::metrics_layout;
+
+constexpr int k_read_retries = 16;
+
+auto shm_name(std::string_view name) -> std::string {
+  std::string s{"/"};
+  s.append(name);
+  return s;
+}
+
+auto header_of(void* base) noexcept -> layout::header* { return static_cast<layout::header*>(base); }
+
+auto slot_at(void* base, std::size_t i) noexcept -> layout::slot* {
+  return reinterpret_cast<layout::slot*>(static_cast<char*>(base) + layout::k_slots_offset) + i;
+}
+
+void copy_name(char* dst, std::size_t cap, std::string_view src) noexcept {
+  const auto n = std::min(src.size(), cap - 1);
+  std::memcpy(dst, src.data(), n);
+  dst[n] = '\0';
+}
+
+auto name_of(const char* src, std::size_t cap) -> std::string {
+  return std::string{src, ::strnlen(src, cap)};
+}
+
+// True if `path` holds a region whose owner has exited without unlinking
+// it (crash, kill -9). Anything else, including foreign files, is left alone.
+auto is_stale(const std::string& path) noexcept -> bool {
+  const detail::fd_guard fd{::shm_open(path.c_str(), O_RDONLY | O_CLOEXEC, 0)};
+  if (!fd) {
+    return false;
+  }
+  layout::header h{};
+  if (::pread(fd.raw_fd(), &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h)) || h.magic != layout::k_magic) {
+    return false;
+  }
+  return h.pid > 0 && ::kill(h.pid, 0) < 0 && errno == ESRCH;
+}
+
+}
+
+void metrics_slot::publish(std::span<const std::uint64_t> values) noexcept {
+  constexpr auto r = std::memory_order_relaxed;
+  const auto n = std::min<std::size_t>(values.size(), slot_->field_count);
+  const auto seq = slot_->seq.load(r);
+  slot_->seq.store(seq + 1, r);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (std::size_t i = 0; i < n; ++i) {
+    slot_->values[i].store(values[i], r);
+  }
+  slot_->published_ns.store(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      loop_clock::sample(clock_mode::coarse).time_since_epoch()
+    ).count(),
+    r
+  );
+  slot_->seq.store(seq + 2, std::memory_order_release);
+}
+
+void metrics_slot::publish(const poll_stats& s) noexcept {
+  publish({
+    s.polls,
+    s.events,
+    s.saturated,
+    static_cast<std::uint64_t>(s.blocked.count()),
+    static_cast<std::uint64_t>(s.dispatching.count()),
+    s.ctl_add,
+    s.ctl_mod,
+    s.ctl_del,
+    s.ctl_errors,
+    s.wakes,
+    s.drains,
+  });
+}
+
+auto metrics_region::create(std::string_view name, std::uint32_t slots) -> result<metrics_region> {
+  if (name.empty() || name.find('/') != std::string_view::npos || slots == 0) {
+    return std::unexpected{error{EINVAL}};
+  }
+
+  // O_EXCL: truncating a region another live process has mapped would make
+  // its next publish fault. A region left behind by a dead owner is
+  // replaced; one with a live owner fails with EEXIST.
+  auto path = shm_name(name);
+  constexpr int flags = O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC;
+  detail::fd_guard fd{::shm_open(path.c_str(), flags, 0644)};
+  if (!fd && errno == EEXIST && is_stale(path)) {
+    ::shm_unlink(path.c_str());
+    fd.reset(::shm_open(path.c_str(), flags, 0644));
+  }
+  if (!fd) {
+    return std::unexpected{error::last_os_error()};
+  }
+
+  const auto size = layout::size(slots);
+  if (::ftruncate(fd.raw_fd(), static_cast<off_t>(size)) < 0) {
+    const auto e = error::last_os_error();
+    ::shm_unlink(path.c_str());
+    return std::unexpected{e};
+  }
+
+  void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd.raw_fd(), 0);
+  if (base == MAP_FAILED) {
+    const auto e = error::last_os_error();
+    ::shm_unlink(path.c_str());
+    return std::unexpected{e};
+  }
+
+  // ftruncate zero-fills, so every slot starts not ready with seq 0.
+  auto* h = header_of(base);
+  h->version = layout::k_version;
+  h->slot_count = slots;
+  h->pid = static_cast<std::int32_t>(::getpid());
+  h->used.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  h->magic = layout::k_magic;
+
+  return metrics_region{std::string{name}, base, size};
+}
+
+metrics_region::metrics_region(metrics_region&& other) noexcept
+  : name_{std::move(other.name_)}, base_{std::exchange(other.base_, nullptr)},
+    size_{std::exchange(other.size_, 0)} {}
+
+auto metrics_region::operator=(metrics_region&& other) noexcept -> metrics_region& {
+  if (this != &other) {
+    release();
+    name_ = std::move(other.name_);
+    base_ = std::exchange(other.base_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+metrics_region::~metrics_region() { release(); }
+
+void metrics_region::release() noexcept {
+  if (base_ != nullptr) {
+    ::munmap(base_, size_);
+    ::shm_unlink(shm_name(name_).c_str());
+    base_ = nullptr;
+  }
+}
+
+auto metrics_region::add(std::string_view label, std::span<const metric_field> fields) -> result<metrics_slot> {
+  if (fields.size() > layout::k_fields) {
+    return std::unexpected{error{EINVAL}};
+  }
+
+  auto* h = header_of(base_);
+  auto idx = h->used.load(std::memory_order_relaxed);
+  do {
+    if (idx == h->slot_count) {
+      return std::unexpected{error{ENOSPC}};
+    }
+  } while (!h->used.compare_exchange_weak(idx, idx + 1, std::memory_order_relaxed));
+
+  auto* s = slot_at(base_, idx);
+  copy_name(s->label, layout::k_label, label);
+  s->field_count = static_cast<std::uint32_t>(fields.size());
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    copy_name(s->field_names[i], layout::k_field_name, fields[i].name);
+    s->field_kinds[i] = fields[i].kind;
+  }
+  s->ready.store(1, std::memory_order_release);
+  return metrics_slot{s};
+}
+
+auto metrics_reader::open(std::string_view name) -> result<metrics_reader> {
+  const auto path = shm_name(name);
+  const detail::fd_guard fd{::shm_open(path.c_str(), O_RDONLY | O_CLOEXEC, 0)};
+  if (fd.raw_fd() < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+
+  struct stat st{};
+  if (::fstat(fd.raw_fd(), &st) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  const auto size = static_cast<std::size_t>(st.st_size);
+  if (size < layout::k_slots_offset) {
+    return std::unexpected{error{EPROTO}};
+  }
+
+  void* base = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd.raw_fd(), 0);
+  if (base == MAP_FAILED) {
+    return std::unexpected{error::last_os_error()};
+  }
+
+  metrics_reader reader{base, size};
+  const auto* h = header_of(base);
+  if (h->magic != layout::k_magic || h->version != layout::k_version || layout::size(h->slot_count) > size) {
+    return std::unexpected{error{EPROTO}};
+  }
+  return reader;
+}
+
+metrics_reader::metrics_reader(metrics_reader&& other) noexcept
+  : base_{std::exchange(other.base_, nullptr)}, size_{std::exchange(other.size_, 0)} {}
+
+auto metrics_reader::operator=(metrics_reader&& other) noexcept -> metrics_reader& {
+  if (this != &other) {
+    release();
+    base_ = std::exchange(other.base_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+metrics_reader::~metrics_reader() { release(); }
+
+void metrics_reader::release() noexcept {
+  if (base_ != nullptr) {
+    ::munmap(base_, size_);
+    base_ = nullptr;
+  }
+}
+
+auto metrics_reader::pid() const noexcept -> int { return header_of(base_)->pid; }
+
+auto metrics_reader::size() const noexcept -> std::size_t {
+  const auto* h = header_of(base_);
+  return std::min(h->used.load(std::memory_order_acquire), h->slot_count);
+}
+
+auto metrics_reader::read(std::size_t i) const -> std::optional<metrics_sample> {
+  if (i >= size()) {
+    return std::nullopt;
+  }
+  const auto* s = slot_at(base_, i);
+  if (s->ready.load(std::memory_order_acquire) == 0) {
+    return std::nullopt;
+  }
+
+  metrics_sample out;
+  const auto n = std::min<std::size_t>(s->field_count, layout::k_fields);
+  out.label = name_of(s->label, layout::k_label);
+  for (std::size_t f = 0; f < n; ++f) {
+    out.names.push_back(name_of(s->field_names[f], layout::k_field_name));
+    out.kinds.push_back(s->field_kinds[f]);
+  }
+  out.values.resize(n);
+
+  constexpr auto r = std::memory_order_relaxed;
+  for (int attempt = 0; attempt < k_read_retries; ++attempt) {
+    const auto before = s->seq.load(std::memory_order_acquire);
+    if ((before & 1) != 0) {
+      continue;
+    }
+    for (std::size_t f = 0; f < n; ++f) {
+      out.values[f] = s->values[f].load(r);
+    }
+    out.published = std::chrono::nanoseconds{s->published_ns.load(r)};
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (s->seq.load(r) == before) {
+      return out;
+    }
+  }
+  return std::nullopt;
+}
+
+}
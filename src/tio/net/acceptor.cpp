@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <algorithm>
+#include <cerrno>
+
+#include <tio/interest.hpp>
+#include <tio/net/acceptor.hpp>
+
+namespace tio::net {
+
+namespace {
+
+auto is_resource_error(const error& e) noexcept -> bool {
+  const int c = e.code();
+  return c == EMFILE || c == ENFILE || c == ENOBUFS || c == ENOMEM;
+}
+
+}
+
+auto acceptor::create(tcp_listener listener, const acceptor_options& opts) -> result<acceptor> {
+  auto p = tio::poll::create();
+  if (!p.has_value()) {
+    return std::unexpected{p.error()};
+  }
+
+  auto reg = p->get_registry();
+  if (auto r = reg.register_source(listener, k_listener_token, interest::readable());
+      !r.has_value()) {
+    return std::unexpected{r.error()};
+  }
+
+  auto w = waker::create(reg, k_stop_token);
+  if (!w.has_value()) {
+    return std::unexpected{w.error()};
+  }
+
+  return acceptor{std::make_unique<state>(
+    std::move(listener), std::move(p.value()), std::move(w.value()), opts
+  )};
+}
+
+auto acceptor::add_worker(const registry& reg, const token tok) -> result<acceptor_inbox*> {
+  auto w = waker::create(reg, tok);
+  if (!w.has_value()) {
+    return std::unexpected{w.error()};
+  }
+
+  state_->inboxes.push_back(
+    std::make_unique<acceptor_inbox>(std::move(w.value()), state_->opts.queue_capacity)
+  );
+  return state_->inboxes.back().get();
+}
+
+auto acceptor::pick(const accepted& c) -> std::size_t {
+  auto& s = *state_;
+  const auto n = s.inboxes.size();
+
+  switch (s.opts.place) {
+  case placement::round_robin:
+    break;
+
+  case placement::least_connections: {
+    std::size_t best = 0;
+    auto best_live = s.inboxes[0]->live_connections();
+    for (std::size_t i = 1; i < n && best_live != 0; ++i) {
+      if (const auto live = s.inboxes[i]->live_connections(); live < best_live) {
+        best = i;
+        best_live = live;
+      }
+    }
+    return best;
+  }
+
+  case placement::incoming_cpu: {
+    const auto cpu = c.first.incoming_cpu();
+    if (!cpu.has_value() || *cpu < 0) {
+      break;
+    }
+    const auto& cpus = s.opts.worker_cpus;
+    if (const auto it = std::ranges::find(cpus, *cpu); it != cpus.end()) {
+      const auto i = static_cast<std::size_t>(it - cpus.begin());
+      if (i < n) {
+        return i;
+      }
+    }
+    return static_cast<std::size_t>(*cpu) % n;
+  }
+  }
+
+  const auto i = s.next;
+  s.next = (s.next + 1) % n;
+  return i;
+}
+
+auto acceptor::hand_off(accepted& c) -> bool {
+  auto& inboxes = state_->inboxes;
+  const auto n = inboxes.size();
+  const auto first = pick(c);
+
+  for (std::size_t k = 0; k < n; ++k) {
+    if (inboxes[(first + k) % n]->try_push(c)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto acceptor::accept_batch() -> result<std::size_t> {
+  auto& s = *state_;
+  if (s.inboxes.empty()) {
+    return std::unexpected{error{EINVAL}};
+  }
+
+  std::size_t handed = 0;
+  s.more = false;
+  s.starved = false;
+
+  if (s.stalled.has_value()) {
+    if (!hand_off(*s.stalled)) {
+      return handed;
+    }
+    s.stalled.reset();
+    ++handed;
+  }
+
+  std::size_t i = 0;
+  for (; i < s.opts.max_batch; ++i) {
+    auto c = s.listener.accept();
+    if (!c.has_value()) {
+      if (c.error().is_would_block()) {
+        break;
+      }
+      if (c.error().is_connection_aborted() || c.error().is_interrupted()) {
+        continue;
+      }
+      if (is_resource_error(c.error())) {
+        // Out of fds or memory: the listener will not fire again for the
+        // connections already queued, so come back for them later.
+        ++s.resource_errors;
+        s.starved = true;
+        break;
+      }
+      for (auto& in : s.inboxes) {
+        in->flush();
+      }
+      return std::unexpected{c.error()};
+    }
+
+    ++s.accepted_total;
+    if (!hand_off(*c)) {
+      s.stalled.emplace(std::move(c.value()));
+      break;
+    }
+    ++handed;
+  }
+
+  // Edge-triggered: a batch that ran all its iterations without EAGAIN, a
+  // stall or a resource error may leave connections in the backlog, even
+  // if the last accept() was aborted or interrupted.
+  s.more = i == s.opts.max_batch;
+
+  for (auto& in : s.inboxes) {
+    in->flush();
+  }
+  return handed;
+}
+
+auto acceptor::run_once(const std::optional<std::chrono::milliseconds> timeout) -> void_result {
+  auto& s = *state_;
+
+  // Backlog left from the last round, or a stalled connection: poll
+  // without blocking so workers get a chance to drain their inboxes. After
+  // a resource error, back off before retrying the backlog.
+  auto wait = timeout;
+  if (s.stalled.has_value()) {
+    wait = std::chrono::milliseconds{1};
+  } else if (s.more) {
+    wait = std::chrono::milliseconds{0};
+  } else if (s.starved) {
+    wait = timeout.has_value() ? std::min(*timeout, s.opts.resource_retry) : s.opts.resource_retry;
+  }
+
+  if (auto r = s.poll.do_poll(s.evs, wait); !r.has_value()) {
+    return r;
+  }
+
+  bool listener_ready = s.more || s.starved || s.stalled.has_value();
+  for (const auto& ev : s.evs) {
+    if (ev.tok() == k_stop_token) {
+      s.stop_waker.drain();
+    } else if (ev.tok() == k_listener_token) {
+      listener_ready = true;
+    }
+  }
+
+  if (!listener_ready) {
+    return {};
+  }
+  if (auto r = accept_batch(); !r.has_value()) {
+    return std::unexpected{r.error()};
+  }
+  return {};
+}
+
+auto acceptor::run(const std::stop_token stop) -> void_result {
+  const std::stop_callback wake_on_stop{stop, [this] {
+    [[maybe_unused]] auto r = state_->stop_waker.wake();
+  }};
+
+  while (!stop.stop_requested()) {
+    if (auto r = run_once(std::nullopt); !r.has_value()) {
+      return r;
+    }
+  }
+  return {};
+}
+
+}
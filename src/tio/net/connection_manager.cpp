@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <cerrno>
+
+#include <tio/interest.hpp>
+#include <tio/net/connection_manager.hpp>
+
+namespace tio::net {
+
+auto connection_manager::create(
+  registry reg,
+  tcp_listener listener,
+  const token listener_tok,
+  const connection_options& opts
+) -> result<connection_manager> {
+  if (opts.max_connections == 0 || opts.max_connections >= k_no_slot || opts.tick.count() <= 0
+      || opts.idle_timeout.count() <= 0) {
+    return std::unexpected{error{EINVAL}};
+  }
+
+  if (auto r = reg.register_source(listener, listener_tok, interest::readable()); !r.has_value()) {
+    return std::unexpected{r.error()};
+  }
+
+  auto s = std::make_unique<state>(std::move(reg), std::move(listener), listener_tok, opts);
+  for (auto i = static_cast<std::uint32_t>(s->slots.size()); i-- > 0;) {
+    s->slots[i].next_free = s->free_head;
+    s->free_head = i;
+  }
+  return connection_manager{std::move(s)};
+}
+
+auto connection_manager::slot_of(const token tok) noexcept -> slot* {
+  const auto base = state_->opts.base_token.value();
+  if (tok.value() < base || tok.value() - base >= state_->slots.size()) {
+    return nullptr;
+  }
+  auto& s = state_->slots[tok.value() - base];
+  return s.stream.has_value() ? &s : nullptr;
+}
+
+auto connection_manager::token_of(const slot& s) const noexcept -> token {
+  return token{state_->opts.base_token.value()
+               + static_cast<std::size_t>(&s - state_->slots.data())};
+}
+
+// The wheel's tick 0 is the first loop time the manager sees.
+void connection_manager::start_clock(const loop_clock::time_point now) noexcept {
+  auto& st = *state_;
+  if (!st.epoch_set) {
+    st.epoch = now;
+    st.epoch_set = true;
+  }
+}
+
+auto connection_manager::tick_of(const loop_clock::time_point t) const noexcept -> std::uint64_t {
+  const auto& st = *state_;
+  if (t <= st.epoch) {
+    return 0;
+  }
+  return static_cast<std::uint64_t>((t - st.epoch) / st.opts.tick);
+}
+
+// Rounds up so a connection is never checked before its deadline.
+void connection_manager::schedule_idle(slot& s) noexcept {
+  auto& st = *state_;
+  const auto deadline = s.last_active + st.opts.idle_timeout;
+  st.wheel.schedule(&s, tick_of(deadline) + 1);
+}
+
+auto connection_manager::admit(tcp_stream stream, const loop_clock::time_point now)
+    -> result<slot*> {
+  auto& st = *state_;
+  start_clock(now);
+  const auto idx = st.free_head;
+  auto& s = st.slots[idx];
+
+  if (auto r = st.reg.register_source(
+        stream, token_of(s), interest::readable() | interest::writable()
+      );
+      !r.has_value()) {
+    return std::unexpected{r.error()};
+  }
+
+  st.free_head = s.next_free;
+  s.next_free = k_no_slot;
+  s.stream.emplace(std::move(stream));
+  s.last_active = now;
+  s.busy = false;
+  schedule_idle(s);
+
+  if (++st.live == st.slots.size()) {
+    pause();
+  }
+  return &s;
+}
+
+auto connection_manager::find(const token tok) noexcept -> tcp_stream* {
+  auto* s = slot_of(tok);
+  return s != nullptr ? &*s->stream : nullptr;
+}
+
+void connection_manager::touch(const token tok, const loop_clock::time_point now) noexcept {
+  if (auto* s = slot_of(tok); s != nullptr) {
+    s->last_active = now;
+  }
+}
+
+void connection_manager::set_busy(const token tok, const bool busy) noexcept {
+  auto* s = slot_of(tok);
+  if (s == nullptr || s->busy == busy) {
+    return;
+  }
+  s->busy = busy;
+  // A connection released during a drain is closed on the next tick.
+  if (!busy && state_->draining) {
+    state_->wheel.schedule(s, state_->wheel.now() + 1);
+  }
+}
+
+void connection_manager::close(const token tok) noexcept {
+  auto* s = slot_of(tok);
+  if (s == nullptr) {
+    return;
+  }
+
+  auto& st = *state_;
+  st.wheel.cancel(s);
+  [[maybe_unused]] auto r = st.reg.deregister_source(*s->stream);
+  s->stream.reset();
+  s->busy = false;
+  s->next_free = st.free_head;
+  st.free_head = static_cast<std::uint32_t>(s - st.slots.data());
+  --st.live;
+
+  if (st.paused && !st.draining) {
+    resume();
+  }
+}
+
+void connection_manager::pause() noexcept {
+  auto& st = *state_;
+  if (st.paused) {
+    return;
+  }
+  [[maybe_unused]] auto r = st.reg.deregister_source(st.listener);
+  st.paused = true;
+}
+
+// Re-adding the listener reports any backlog that queued up while paused,
+// since epoll checks readiness on EPOLL_CTL_ADD.
+void connection_manager::resume() noexcept {
+  auto& st = *state_;
+  if (st.reg.register_source(st.listener, st.listener_tok, interest::readable()).has_value()) {
+    st.paused = false;
+  }
+}
+
+void connection_manager::begin_drain(
+  const loop_clock::time_point now, const std::chrono::milliseconds grace
+) noexcept {
+  auto& st = *state_;
+  if (st.draining) {
+    return;
+  }
+  start_clock(now);
+  pause();
+  st.draining = true;
+  st.drain_deadline = now + grace;
+
+  const auto next = st.wheel.now() + 1;
+  for (auto& s : st.slots) {
+    if (s.stream.has_value()) {
+      st.wheel.schedule(&s, next);
+    }
+  }
+}
+
+auto connection_manager::collect_expired(const loop_clock::time_point now) -> slot* {
+  auto& st = *state_;
+  start_clock(now);
+  slot* head = nullptr;
+
+  st.wheel.advance(tick_of(now), [&](detail::wheel_node* n) {
+    auto& s = static_cast<slot&>(*n);
+    if (st.draining) {
+      if (s.busy && now < st.drain_deadline) {
+        st.wheel.schedule(&s, tick_of(st.drain_deadline) + 1);
+        return;
+      }
+    } else if (s.busy) {
+      s.last_active = now;
+      schedule_idle(s);
+      return;
+    } else if (s.last_active + st.opts.idle_timeout > now) {
+      schedule_idle(s);
+      return;
+    }
+    s.next_expired = head;
+    head = &s;
+  });
+  return head;
+}
+
+// The next bucket fires once `tick_of(now)` reaches it, i.e. at the start
+// of its tick; count from `now` so time already spent in the current tick
+// (or since the last `expire`) is not waited again.
+auto connection_manager::next_timeout(const loop_clock::time_point now) const noexcept
+  -> std::optional<std::chrono::milliseconds> {
+  const auto& st = *state_;
+  if (st.wheel.size() == 0) {
+    return std::nullopt;
+  }
+  const auto due = st.epoch + st.opts.tick * static_cast<std::int64_t>(st.wheel.now() + st.wheel.ticks_to_next());
+  if (due <= now) {
+    return std::chrono::milliseconds::zero();
+  }
+  return std::chrono::ceil<std::chrono::milliseconds>(due - now);
+}
+
+}
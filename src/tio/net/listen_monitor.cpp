@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <string>
+#include <string_view>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <tio/net/listen_monitor.hpp>
+
+namespace tio::net {
+
+namespace {
+
+// TCP_LISTEN from the kernel's tcp_states.h.
+constexpr std::uint32_t k_tcp_listen = 10;
+
+auto read_file(const char* path) -> result<std::string> {
+  const detail::fd_guard fd{::open(path, O_RDONLY | O_CLOEXEC)};
+  if (!fd) {
+    return std::unexpected{error::last_os_error()};
+  }
+
+  std::string out;
+  char chunk[4096];
+  for (;;) {
+    const auto n = ::read(fd.raw_fd(), chunk, sizeof(chunk));
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return std::unexpected{error::last_os_error()};
+    }
+    if (n == 0) {
+      return out;
+    }
+    out.append(chunk, static_cast<std::size_t>(n));
+  }
+}
+
+auto next_line(std::string_view& text) -> std::string_view {
+  const auto end = text.find('\n');
+  const auto line = text.substr(0, end);
+  text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+  return line;
+}
+
+auto next_field(std::string_view& line) -> std::string_view {
+  const auto start = line.find_first_not_of(' ');
+  if (start == std::string_view::npos) {
+    line = {};
+    return {};
+  }
+  line.remove_prefix(start);
+  const auto end = std::min(line.find(' '), line.size());
+  const auto field = line.substr(0, end);
+  line.remove_prefix(end);
+  return field;
+}
+
+// /proc/net/netstat holds pairs of lines, names then values, each starting
+// with the same "Prefix:" tag.
+auto parse_tcp_ext(std::string_view text) -> result<listen_drops> {
+  constexpr std::string_view tag = "TcpExt:";
+  while (!text.empty()) {
+    auto names = next_line(text);
+    if (!names.starts_with(tag)) {
+      continue;
+    }
+    auto values = next_line(text);
+    if (!values.starts_with(tag)) {
+      break;
+    }
+    names.remove_prefix(tag.size());
+    values.remove_prefix(tag.size());
+
+    listen_drops out;
+    int found = 0;
+    for (auto name = next_field(names), value = next_field(values); !name.empty() && !value.empty();
+         name = next_field(names), value = next_field(values)) {
+      std::uint64_t* dst = name == "ListenOverflows" ? &out.overflows : name == "ListenDrops" ? &out.drops : nullptr;
+      if (dst == nullptr) {
+        continue;
+      }
+      if (std::from_chars(value.data(), value.data() + value.size(), *dst).ec != std::errc{}) {
+        return std::unexpected{error{EPROTO}};
+      }
+      ++found;
+    }
+    if (found == 2) {
+      return out;
+    }
+    break;
+  }
+  return std::unexpected{error{EPROTO}};
+}
+
+auto growth(std::uint64_t now, std::uint64_t before) noexcept -> std::uint64_t {
+  return now >= before ? now - before : 0;
+}
+
+}
+
+auto listen_monitor::create() -> result<listen_monitor> {
+  const int fd = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+  if (fd < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  return listen_monitor{detail::fd_guard{fd}};
+}
+
+auto listen_monitor::watch_fd(const int listener_fd) -> void_result {
+  struct stat st{};
+  if (::fstat(listener_fd, &st) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  if (!S_ISSOCK(st.st_mode)) {
+    return std::unexpected{error{ENOTSOCK}};
+  }
+
+  sockaddr_storage addr{};
+  socklen_t len = sizeof(addr);
+  if (::getsockname(listener_fd, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  if (addr.ss_family != AF_INET && addr.ss_family != AF_INET6) {
+    return std::unexpected{error{EAFNOSUPPORT}};
+  }
+
+  const auto inode = static_cast<std::uint64_t>(st.st_ino);
+  if (std::ranges::none_of(watched_, [&](const watched& w) { return w.inode == inode; })) {
+    watched_.push_back(watched{inode, addr.ss_family});
+  }
+  return {};
+}
+
+auto listen_monitor::begin() -> void_result {
+  if (dumping_ != 0) {
+    return std::unexpected{error{EALREADY}};
+  }
+  if (watched_.empty()) {
+    return std::unexpected{error{EINVAL}};
+  }
+
+  partial_.clear();
+  const bool any_v4 = std::ranges::any_of(watched_, [](const watched& w) { return w.family == AF_INET; });
+  return request(any_v4 ? AF_INET : AF_INET6);
+}
+
+auto listen_monitor::request(const int family) -> void_result {
+  struct {
+    nlmsghdr hdr;
+    inet_diag_req_v2 req;
+  } msg{};
+
+  msg.hdr.nlmsg_len = sizeof(msg);
+  msg.hdr.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+  msg.hdr.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+  msg.hdr.nlmsg_seq = ++seq_;
+  msg.req.sdiag_family = static_cast<std::uint8_t>(family);
+  msg.req.sdiag_protocol = IPPROTO_TCP;
+  msg.req.idiag_states = 1u << k_tcp_listen;
+
+  sockaddr_nl kernel{};
+  kernel.nl_family = AF_NETLINK;
+
+  if (::sendto(fd_.raw_fd(), &msg, sizeof(msg), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) < 0) {
+    const auto e = error::last_os_error();
+    reset();
+    return std::unexpected{e};
+  }
+  dumping_ = family;
+  return {};
+}
+
+auto listen_monitor::on_readable() -> result<std::optional<listen_sample>> {
+  for (;;) {
+    const auto n = ::recv(fd_.raw_fd(), buf_.data(), buf_.size(), 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      const auto e = error::last_os_error();
+      if (e.is_would_block()) {
+        return std::nullopt;
+      }
+      reset();
+      return std::unexpected{e};
+    }
+
+    // Replies to an abandoned sample carry an older sequence number and are
+    // dropped, as is anything that arrives while idle.
+    auto left = static_cast<int>(n);
+    for (auto* h = reinterpret_cast<nlmsghdr*>(buf_.data()); NLMSG_OK(h, left); h = NLMSG_NEXT(h, left)) {
+      if (dumping_ == 0 || h->nlmsg_seq != seq_) {
+        continue;
+      }
+
+      if (h->nlmsg_type == NLMSG_DONE) {
+        const bool v6_next = dumping_ == AF_INET &&
+                             std::ranges::any_of(watched_, [](const watched& w) { return w.family == AF_INET6; });
+        if (!v6_next) {
+          return finish();
+        }
+        if (auto r = request(AF_INET6); !r.has_value()) {
+          return std::unexpected{r.error()};
+        }
+        break;
+      }
+
+      if (h->nlmsg_type == NLMSG_ERROR) {
+        const auto* err = static_cast<const nlmsgerr*>(NLMSG_DATA(h));
+        reset();
+        return std::unexpected{error{err->error != 0 ? -err->error : EPROTO}};
+      }
+
+      if (h->nlmsg_type != SOCK_DIAG_BY_FAMILY || h->nlmsg_len < NLMSG_LENGTH(sizeof(inet_diag_msg))) {
+        continue;
+      }
+
+      const auto* d = static_cast<const inet_diag_msg*>(NLMSG_DATA(h));
+      const auto inode = static_cast<std::uint64_t>(d->idiag_inode);
+      if (std::ranges::any_of(watched_, [&](const watched& w) { return w.inode == inode; })) {
+        partial_.push_back(listen_queue{
+          .inode = inode,
+          .port = ntohs(d->id.idiag_sport),
+          .queued = d->idiag_rqueue,
+          .backlog = d->idiag_wqueue,
+        });
+      }
+    }
+  }
+}
+
+auto listen_monitor::finish() -> result<listen_sample> {
+  auto drops = read_drops();
+  if (!drops.has_value()) {
+    reset();
+    return std::unexpected{drops.error()};
+  }
+
+  listen_sample out;
+  out.listeners = std::move(partial_);
+  out.total = *drops;
+  if (last_.has_value()) {
+    out.delta.overflows = growth(drops->overflows, last_->overflows);
+    out.delta.drops = growth(drops->drops, last_->drops);
+  }
+  last_ = *drops;
+  reset();
+  return out;
+}
+
+void listen_monitor::reset() noexcept {
+  dumping_ = 0;
+  partial_.clear();
+}
+
+auto listen_monitor::sample(const std::chrono::milliseconds timeout) -> result<listen_sample> {
+  if (auto r = begin(); !r.has_value()) {
+    return std::unexpected{r.error()};
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (;;) {
+    if (auto r = on_readable(); !r.has_value()) {
+      return std::unexpected{r.error()};
+    } else if (r->has_value()) {
+      return std::move(**r);
+    }
+
+    const auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    if (left <= std::chrono::milliseconds::zero()) {
+      reset();
+      return std::unexpected{error{ETIMEDOUT}};
+    }
+    pollfd pfd{.fd = fd_.raw_fd(), .events = POLLIN, .revents = 0};
+    if (::poll(&pfd, 1, static_cast<int>(left.count())) < 0 && errno != EINTR) {
+      const auto e = error::last_os_error();
+      reset();
+      return std::unexpected{e};
+    }
+  }
+}
+
+auto listen_monitor::read_drops() -> result<listen_drops> {
+  auto text = read_file("/proc/net/netstat");
+  if (!text.has_value()) {
+    return std::unexpected{text.error()};
+  }
+  return parse_tcp_ext(*text);
+}
+
+}
@@ -12,6 +12,7 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <tio/net/tcp_listener.hpp>
+#include <tio/sys/detail/usdt.hpp>
 
 namespace tio::net {
 
@@ -49,8 +50,11 @@ auto tcp_listener::accept() const -> result<std::pair<tcp_stream, detail::socket
   );
 
   if (fd < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(accept, fd_.raw_fd(), -1, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(accept, fd_.raw_fd(), fd, 0);
 
   const auto peer = detail::socket_addr::from_raw(reinterpret_cast<sockaddr*>(&storage), len);
   return std::pair{tcp_stream{detail::fd_guard{fd}}, peer};
@@ -15,6 +15,7 @@
 #include <sys/uio.h>
 
 #include <tio/net/tcp_stream.hpp>
+#include <tio/sys/detail/usdt.hpp>
 
 #include <unistd.h>
 
@@ -42,16 +43,22 @@ auto tcp_stream::connect(const detail::socket_addr& addr) -> result<tcp_stream>
 auto tcp_stream::read(std::span<std::byte> buf) const -> result<std::size_t> {
   const ssize_t n = ::recv(fd_.raw_fd(), buf.data(), buf.size(), 0);
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(read, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(read, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
 auto tcp_stream::write(const std::span<const std::byte> buf) const -> result<std::size_t> {
   const ssize_t n = send(fd_.raw_fd(), buf.data(), buf.size(), MSG_NOSIGNAL);
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(write, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(write, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
@@ -122,6 +129,15 @@ auto tcp_stream::ttl() const -> result<std::uint32_t> {
   return static_cast<std::uint32_t>(val);
 }
 
+auto tcp_stream::incoming_cpu() const -> result<int> {
+  int val = 0;
+  socklen_t len = sizeof(val);
+  if (::getsockopt(fd_.raw_fd(), SOL_SOCKET, SO_INCOMING_CPU, &val, &len) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  return val;
+}
+
 auto tcp_stream::take_error() const -> result<error> {
   int val = 0;
   socklen_t len = sizeof(val);
@@ -134,16 +150,22 @@ auto tcp_stream::take_error() const -> result<error> {
 auto tcp_stream::read_vectored(std::span<iovec> bufs) const -> result<std::size_t> {
   const ssize_t n = ::readv(fd_.raw_fd(), bufs.data(), static_cast<int>(bufs.size()));
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(read, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(read, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
 auto tcp_stream::write_vectored(std::span<const iovec> bufs) const -> result<std::size_t> {
   const ssize_t n = ::writev(fd_.raw_fd(), bufs.data(), static_cast<int>(bufs.size()));
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(write, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(write, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
@@ -13,6 +13,8 @@
 #include <sys/socket.h>
 
 #include <tio/net/udp_socket.hpp>
+#include <tio/sys/detail/recv_drops.hpp>
+#include <tio/sys/detail/usdt.hpp>
 
 namespace tio::net {
 
@@ -36,8 +38,11 @@ auto udp_socket::send_to(std::span<const std::byte> buf, const detail::socket_ad
   const ssize_t n =
       ::sendto(fd_.raw_fd(), buf.data(), buf.size(), MSG_NOSIGNAL, addr.as_sockaddr(), addr.len());
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(send, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(send, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
@@ -56,9 +61,12 @@ auto udp_socket::recv_from(std::span<std::byte> buf) const
   );
 
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(recv, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
 
+  TIO_PROBE3(recv, fd_.raw_fd(), n, 0);
   const auto sender = detail::socket_addr::from_raw(reinterpret_cast<sockaddr*>(&storage), len);
   return std::pair{static_cast<std::size_t>(n), sender};
 }
@@ -73,16 +81,51 @@ auto udp_socket::connect(const detail::socket_addr& addr) const -> void_result {
 auto udp_socket::send(const std::span<const std::byte> buf) const -> result<std::size_t> {
   const ssize_t n = ::send(fd_.raw_fd(), buf.data(), buf.size(), MSG_NOSIGNAL);
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(send, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(send, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
 auto udp_socket::recv(std::span<std::byte> buf) const -> result<std::size_t> {
   const ssize_t n = ::recv(fd_.raw_fd(), buf.data(), buf.size(), 0);
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(recv, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
+  }
+  TIO_PROBE3(recv, fd_.raw_fd(), n, 0);
+  return static_cast<std::size_t>(n);
+}
+
+auto udp_socket::recv_from(std::span<std::byte> buf, rx_drops& drops) const
+    -> result<std::pair<std::size_t, detail::socket_addr>> {
+  sockaddr_storage storage{};
+  socklen_t len = sizeof(storage);
+
+  const ssize_t n =
+      detail::recv_counting_drops(fd_.raw_fd(), buf, reinterpret_cast<sockaddr*>(&storage), &len, drops);
+  if (n < 0) {
+    const auto e = error::last_os_error();
+    TIO_PROBE3(recv, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
+  }
+
+  TIO_PROBE3(recv, fd_.raw_fd(), n, 0);
+  const auto sender = detail::socket_addr::from_raw(reinterpret_cast<sockaddr*>(&storage), len);
+  return std::pair{static_cast<std::size_t>(n), sender};
+}
+
+auto udp_socket::recv(std::span<std::byte> buf, rx_drops& drops) const -> result<std::size_t> {
+  const ssize_t n = detail::recv_counting_drops(fd_.raw_fd(), buf, nullptr, nullptr, drops);
+  if (n < 0) {
+    const auto e = error::last_os_error();
+    TIO_PROBE3(recv, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(recv, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
@@ -146,6 +189,23 @@ auto udp_socket::broadcast() const -> result<bool> {
   return val != 0;
 }
 
+auto udp_socket::set_rxq_overflow(const bool enable) const -> void_result {
+  const int val = enable ? 1 : 0;
+  if (::setsockopt(fd_.raw_fd(), SOL_SOCKET, SO_RXQ_OVFL, &val, sizeof(val)) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  return {};
+}
+
+auto udp_socket::rxq_overflow() const -> result<bool> {
+  int val = 0;
+  socklen_t len = sizeof(val);
+  if (::getsockopt(fd_.raw_fd(), SOL_SOCKET, SO_RXQ_OVFL, &val, &len) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  return val != 0;
+}
+
 auto udp_socket::peer_addr() const -> result<detail::socket_addr> {
   detail::socket_addr addr;
   socklen_t len = addr.len();
@@ -9,40 +9,187 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
 #include <tio/poll.hpp>
 
 namespace tio {
 
+namespace {
+
+using ctl_counter = std::atomic<std::uint64_t> detail::poll_counters::*;
+
+// Accounts one epoll_ctl call in the stats and the flight recorder.
+auto counted(
+  const detail::poll_state& state,
+  ctl_counter which,
+  flight_event kind,
+  int fd,
+  token tok,
+  interest intr,
+  void_result r
+) -> void_result {
+  if (auto* stats = state.stats.get(); stats != nullptr) {
+    (stats->*which).fetch_add(1, std::memory_order_relaxed);
+    if (!r.has_value()) {
+      stats->ctl_errors.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  if (auto* rec = state.recorder.get(); rec != nullptr) {
+    rec->record(
+      kind,
+      rec->now(),
+      loop_clock::duration::zero(),
+      tok.value(),
+      static_cast<std::uint64_t>(fd),
+      intr.raw(),
+      r.has_value() ? 0 : r.error().code()
+    );
+  }
+  return r;
+}
+
+}
+
 auto registry::register_fd(int fd, token tok, interest interest) const -> void_result {
-  return sel_->register_fd(fd, tok, interest);
+  auto* table = state_->table.get();
+  if (table == nullptr) {
+    return counted(
+      *state_, &detail::poll_counters::ctl_add, flight_event::register_fd, fd, tok, interest,
+      state_->sel.register_fd(fd, tok, interest)
+    );
+  }
+
+  const std::lock_guard lock{state_->table_mu};
+  if (table->contains(fd)) {
+    return std::unexpected{error{EEXIST}};
+  }
+
+  auto r = counted(
+    *state_, &detail::poll_counters::ctl_add, flight_event::register_fd, fd, tok, interest,
+    state_->sel.register_fd(fd, tok, interest)
+  );
+  if (r.has_value()) {
+    table->insert(fd, tok, interest);
+  }
+  return r;
 }
 
 auto registry::reregister_fd(int fd, token tok, interest intr) const -> void_result {
-  return sel_->reregister_fd(fd, tok, intr);
+  auto* table = state_->table.get();
+  if (table == nullptr) {
+    return counted(
+      *state_, &detail::poll_counters::ctl_mod, flight_event::reregister_fd, fd, tok, intr,
+      state_->sel.reregister_fd(fd, tok, intr)
+    );
+  }
+
+  const std::lock_guard lock{state_->table_mu};
+  if (!table->contains(fd)) {
+    return std::unexpected{error{ENOENT}};
+  }
+
+  if (table->matches(fd, tok, intr)) {
+    table->note_elided();
+    return {};
+  }
+
+  auto r = counted(
+    *state_, &detail::poll_counters::ctl_mod, flight_event::reregister_fd, fd, tok, intr,
+    state_->sel.reregister_fd(fd, tok, intr)
+  );
+  if (r.has_value()) {
+    table->insert(fd, tok, intr);
+  }
+  return r;
 }
 
 auto registry::deregister_fd(int fd) const -> void_result {
-  return sel_->deregister_fd(fd);
+  auto* table = state_->table.get();
+  if (table == nullptr) {
+    return counted(
+      *state_, &detail::poll_counters::ctl_del, flight_event::deregister_fd, fd, token{0}, interest{},
+      state_->sel.deregister_fd(fd)
+    );
+  }
+
+  const std::lock_guard lock{state_->table_mu};
+  if (!table->contains(fd)) {
+    return std::unexpected{error{ENOENT}};
+  }
+
+  auto r = counted(
+    *state_, &detail::poll_counters::ctl_del, flight_event::deregister_fd, fd, token{0}, interest{},
+    state_->sel.deregister_fd(fd)
+  );
+  if (r.has_value() || r.error().code() == ENOENT || r.error().code() == EBADF) {
+    table->erase(fd);
+  }
+  return r;
+}
+
+auto registry::stats() const noexcept -> std::optional<poll_stats> {
+  if (state_->stats == nullptr) {
+    return std::nullopt;
+  }
+  return state_->stats->snapshot();
 }
 
 auto registry::try_clone() const -> result<registry> {
-  auto cloned = sel_->try_clone();
-  if (!cloned.has_value()) {
-    return std::unexpected{cloned.error()};
+  if (owner_ != nullptr) {
+    return registry{owner_};
   }
-  return registry{sel_};
+  return registry{state_->shared_from_this()};
 }
 
-poll::poll(sys::selector sel) noexcept : sel_{std::move(sel)} {}
+auto registry::registration_of(int fd) const -> std::optional<registration> {
+  if (state_->table == nullptr) {
+    return std::nullopt;
+  }
+  const std::lock_guard lock{state_->table_mu};
+  return state_->table->find(fd);
+}
+
+auto registry::registered_count() const -> std::size_t {
+  if (state_->table == nullptr) {
+    return 0;
+  }
+  const std::lock_guard lock{state_->table_mu};
+  return state_->table->size();
+}
+
+auto registry::elided_count() const -> std::size_t {
+  if (state_->table == nullptr) {
+    return 0;
+  }
+  const std::lock_guard lock{state_->table_mu};
+  return state_->table->elided();
+}
+
+poll::poll(std::shared_ptr<detail::poll_state> state, const poll_options& opts) noexcept
+  : state_{std::move(state)}, clock_{opts.clock} {}
 
 auto poll::create() -> result<poll> {
+  return create(poll_options{});
+}
+
+auto poll::create(const poll_options& opts) -> result<poll> {
   auto sel = sys::selector::create();
 
   if (!sel.has_value()) {
     return std::unexpected{sel.error()};
   }
 
-  return poll{std::move(sel.value())};
+  auto state = std::make_shared<detail::poll_state>(
+    std::move(sel.value()),
+    opts.track_registrations,
+    opts.collect_stats,
+    opts.record_latency ? std::make_unique<poll_latency>(opts.handler_classes) : nullptr,
+    opts.flight_records != 0 ? std::make_shared<flight_recorder>(opts.flight_records, opts.clock) : nullptr
+  );
+  return poll{std::move(state), opts};
 }
 
 auto poll::do_poll(
@@ -51,13 +198,77 @@ auto poll::do_poll(
 ) -> void_result {
   evs.clear();
 
-  auto n = sel_.select(evs.raw_buf(), evs.raw_capacity(), timeout);
+  // The clock still holds the previous return, so entry - now() is the
+  // time the caller spent dispatching that batch.
+  auto* stats = state_->stats.get();
+  auto* lat = state_->latency.get();
+  auto* rec = state_->recorder.get();
+  loop_clock::time_point entered{};
+  loop_clock::duration dispatching{};
+  if (stats != nullptr || lat != nullptr || rec != nullptr) {
+    entered = loop_clock::sample(clock_.mode());
+    if (primed_) {
+      dispatching = std::max(entered - clock_.now(), loop_clock::duration::zero());
+    }
+  }
+
+  auto& beat = state_->beat;
+  beat.tok.store(detail::heartbeat::k_no_token, std::memory_order_relaxed);
+  beat.thread.store(detail::current_thread_id(), std::memory_order_relaxed);
+  beat.in_select.store(true, std::memory_order_release);
+
+  auto n = state_->sel.select(evs.raw_buf(), evs.raw_capacity(), timeout);
+  clock_.update();
+
+  beat.mode.store(clock_.mode(), std::memory_order_relaxed);
+  beat.returned_ns.store(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(clock_.now().time_since_epoch()).count(),
+    std::memory_order_relaxed
+  );
+  beat.iterations.store(beat.iterations.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  beat.in_select.store(false, std::memory_order_release);
   if (!n.has_value()) {
     return std::unexpected{n.error()};
   }
 
-  evs.set_len(static_cast<std::size_t>(n.value()));
+  const auto len = static_cast<std::size_t>(n.value());
+  evs.set_len(len);
+  const auto blocked = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_.now() - entered);
+  if (stats != nullptr) {
+    stats->on_poll(len, evs.capacity(), blocked, std::chrono::duration_cast<std::chrono::nanoseconds>(dispatching));
+  }
+  if (lat != nullptr) {
+    lat->wait.record(blocked);
+    if (primed_) {
+      lat->dispatch.record(std::chrono::duration_cast<std::chrono::nanoseconds>(dispatching));
+    }
+  }
+  if (rec != nullptr) {
+    rec->record(flight_event::poll_wait, entered, clock_.now() - entered, 0, len);
+  }
+  primed_ = true;
   return {};
 }
 
+void poll::record_handler(std::size_t cls) noexcept {
+  auto* lat = state_->latency.get();
+  if (lat == nullptr || cls >= lat->handler_classes()) {
+    return;
+  }
+  lat->handler(cls).record(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(loop_clock::sample(clock_.mode()) - clock_.now())
+  );
+}
+
+void poll::mark_dispatch(token tok) noexcept {
+  // Same clock as `returned_ns`, even if the mode changed mid-iteration.
+  auto& beat = state_->beat;
+  const auto mode = beat.mode.load(std::memory_order_relaxed);
+  beat.tok_ns.store(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(loop_clock::sample(mode).time_since_epoch()).count(),
+    std::memory_order_relaxed
+  );
+  beat.tok.store(tok.value(), std::memory_order_release);
+}
+
 }
@@ -11,6 +11,7 @@
 
 #include <sys/epoll.h>
 #include <unistd.h>
+#include <tio/sys/detail/usdt.hpp>
 #include <tio/sys/unix_/epoll_selector.hpp>
 
 namespace tio::sys::unix {
@@ -39,14 +40,18 @@ auto epoll_selector::select(
     timeout_ms = static_cast<int>(timeout->count());
   }
 
+  TIO_PROBE3(poll_enter, epoll_fd_.raw_fd(), timeout_ms, max_events);
   int n = 0;
   do {
     n = epoll_wait(epoll_fd_.raw_fd(), events, max_events, timeout_ms);
   } while (n < 0 && errno == EINTR);
 
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(poll_exit, epoll_fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(poll_exit, epoll_fd_.raw_fd(), n, 0);
   return n;
 }
 
@@ -60,9 +65,12 @@ auto epoll_selector::register_fd(
   ev.data.u64 = tok.value();
 
   if (epoll_ctl(epoll_fd_.raw_fd(), EPOLL_CTL_ADD, fd, &ev) < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE4(register, fd, tok.value(), interest.raw(), e.code());
+    return std::unexpected{e};
   }
 
+  TIO_PROBE4(register, fd, tok.value(), interest.raw(), 0);
   return {};
 }
 
@@ -76,18 +84,24 @@ auto epoll_selector::reregister_fd(
   ev.data.u64 = tok.value();
 
   if (epoll_ctl(epoll_fd_.raw_fd(), EPOLL_CTL_MOD, fd, &ev) < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE4(reregister, fd, tok.value(), interest.raw(), e.code());
+    return std::unexpected{e};
   }
 
+  TIO_PROBE4(reregister, fd, tok.value(), interest.raw(), 0);
   return {};
 }
 
 auto epoll_selector::deregister_fd(const int fd) const -> void_result {
 
   if (epoll_ctl(epoll_fd_.raw_fd(), EPOLL_CTL_DEL, fd, nullptr) < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE2(deregister, fd, e.code());
+    return std::unexpected{e};
   }
 
+  TIO_PROBE2(deregister, fd, 0);
   return {};
 }
 
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#include <tio/sys/unix_/futex.hpp>
+
+#include <unistd.h>
+
+namespace tio::sys::unix {
+
+namespace {
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t));
+
+auto word_of(const std::atomic<std::uint32_t>& word) noexcept -> const std::uint32_t* {
+  return reinterpret_cast<const std::uint32_t*>(&word);
+}
+
+}
+
+void futex_wait(const std::atomic<std::uint32_t>& word, const std::uint32_t expected) noexcept {
+  ::syscall(SYS_futex, word_of(word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void futex_wake(const std::atomic<std::uint32_t>& word, const int count) noexcept {
+  ::syscall(SYS_futex, word_of(word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+}
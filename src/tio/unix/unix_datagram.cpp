@@ -12,6 +12,8 @@
 #include <sys/socket.h>
 
 #include <tio/unix/unix_datagram.hpp>
+#include <tio/sys/detail/recv_drops.hpp>
+#include <tio/sys/detail/usdt.hpp>
 
 namespace tio::unix_ {
 
@@ -58,8 +60,11 @@ auto unix_datagram::send_to(std::span<const std::byte> buf, const detail::unix_a
   const ssize_t n =
       ::sendto(fd_.raw_fd(), buf.data(), buf.size(), MSG_NOSIGNAL, addr.as_sockaddr(), addr.len());
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(send, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(send, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
@@ -75,9 +80,12 @@ auto unix_datagram::recv_from(std::span<std::byte> buf) const
                          reinterpret_cast<sockaddr*>(&storage),
                          &len);
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(recv, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
 
+  TIO_PROBE3(recv, fd_.raw_fd(), n, 0);
   auto sender = detail::unix_addr::from_raw(reinterpret_cast<sockaddr*>(&storage), len);
   return std::pair{static_cast<std::size_t>(n), sender};
 }
@@ -85,16 +93,51 @@ auto unix_datagram::recv_from(std::span<std::byte> buf) const
 auto unix_datagram::send(std::span<const std::byte> buf) const -> result<std::size_t> {
   const ssize_t n = ::send(fd_.raw_fd(), buf.data(), buf.size(), MSG_NOSIGNAL);
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(send, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(send, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
 auto unix_datagram::recv(std::span<std::byte> buf) const -> result<std::size_t> {
   const ssize_t n = ::recv(fd_.raw_fd(), buf.data(), buf.size(), 0);
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(recv, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
+  }
+  TIO_PROBE3(recv, fd_.raw_fd(), n, 0);
+  return static_cast<std::size_t>(n);
+}
+
+auto unix_datagram::recv_from(std::span<std::byte> buf, rx_drops& drops) const
+    -> result<std::pair<std::size_t, detail::unix_addr>> {
+  sockaddr_un storage{};
+  socklen_t len = sizeof(storage);
+
+  const ssize_t n =
+      detail::recv_counting_drops(fd_.raw_fd(), buf, reinterpret_cast<sockaddr*>(&storage), &len, drops);
+  if (n < 0) {
+    const auto e = error::last_os_error();
+    TIO_PROBE3(recv, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
+  }
+
+  TIO_PROBE3(recv, fd_.raw_fd(), n, 0);
+  auto sender = detail::unix_addr::from_raw(reinterpret_cast<sockaddr*>(&storage), len);
+  return std::pair{static_cast<std::size_t>(n), sender};
+}
+
+auto unix_datagram::recv(std::span<std::byte> buf, rx_drops& drops) const -> result<std::size_t> {
+  const ssize_t n = detail::recv_counting_drops(fd_.raw_fd(), buf, nullptr, nullptr, drops);
+  if (n < 0) {
+    const auto e = error::last_os_error();
+    TIO_PROBE3(recv, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(recv, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
@@ -125,6 +168,23 @@ auto unix_datagram::shutdown(int how) const -> void_result {
   return {};
 }
 
+auto unix_datagram::set_rxq_overflow(const bool enable) const -> void_result {
+  const int val = enable ? 1 : 0;
+  if (::setsockopt(fd_.raw_fd(), SOL_SOCKET, SO_RXQ_OVFL, &val, sizeof(val)) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  return {};
+}
+
+auto unix_datagram::rxq_overflow() const -> result<bool> {
+  int val = 0;
+  socklen_t len = sizeof(val);
+  if (::getsockopt(fd_.raw_fd(), SOL_SOCKET, SO_RXQ_OVFL, &val, &len) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  return val != 0;
+}
+
 auto unix_datagram::take_error() const -> result<error> {
   int val = 0;
   socklen_t len = sizeof(val);
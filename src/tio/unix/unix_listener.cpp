@@ -13,6 +13,7 @@
 
 #include <tio/unix/unix_listener.hpp>
 #include <tio/unix/unix_stream.hpp>
+#include <tio/sys/detail/usdt.hpp>
 
 namespace tio::unix_ {
 
@@ -44,8 +45,11 @@ auto unix_listener::accept() const -> result<std::pair<unix_stream, detail::unix
                      &len,
                      SOCK_NONBLOCK | SOCK_CLOEXEC);
   if (fd < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(accept, fd_.raw_fd(), -1, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(accept, fd_.raw_fd(), fd, 0);
 
   auto peer = detail::unix_addr::from_raw(reinterpret_cast<sockaddr*>(&storage), len);
   return std::pair{unix_stream{detail::fd_guard{fd}}, peer};
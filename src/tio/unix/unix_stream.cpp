@@ -13,6 +13,7 @@
 #include <sys/uio.h>
 
 #include <tio/unix/unix_stream.hpp>
+#include <tio/sys/detail/usdt.hpp>
 
 namespace tio::unix_ {
 
@@ -46,16 +47,22 @@ auto unix_stream::pair() -> result<std::pair<unix_stream, unix_stream>> {
 auto unix_stream::read(std::span<std::byte> buf) const -> result<std::size_t> {
   const ssize_t n = ::recv(fd_.raw_fd(), buf.data(), buf.size(), 0);
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(read, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(read, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
 auto unix_stream::write(std::span<const std::byte> buf) const -> result<std::size_t> {
   const ssize_t n = ::send(fd_.raw_fd(), buf.data(), buf.size(), MSG_NOSIGNAL);
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(write, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(write, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
@@ -106,16 +113,22 @@ auto unix_stream::take_error() const -> result<error> {
 auto unix_stream::read_vectored(std::span<iovec> bufs) const -> result<std::size_t> {
   const ssize_t n = ::readv(fd_.raw_fd(), bufs.data(), static_cast<int>(bufs.size()));
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(read, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(read, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
 auto unix_stream::write_vectored(std::span<const iovec> bufs) const -> result<std::size_t> {
   const ssize_t n = ::writev(fd_.raw_fd(), bufs.data(), static_cast<int>(bufs.size()));
   if (n < 0) {
-    return std::unexpected{error::last_os_error()};
+    const auto e = error::last_os_error();
+    TIO_PROBE3(write, fd_.raw_fd(), 0, e.code());
+    return std::unexpected{e};
   }
+  TIO_PROBE3(write, fd_.raw_fd(), n, 0);
   return static_cast<std::size_t>(n);
 }
 
@@ -25,7 +25,7 @@ auto waker::create(registry reg, token tok) -> result<waker> {
     return std::unexpected{r.error()};
   }
 
-  auto p = std::make_shared<inner>(std::move(ew.value()));
+  auto p = std::make_shared<inner>(std::move(ew.value()), reg.state_->stats, reg.state_->recorder, tok);
   return waker{std::move(p)};
 }
 
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <tio/watchdog.hpp>
+
+namespace tio {
+
+namespace detail {
+
+// `key` identifies the poll without locking `state`.
+struct watched {
+  std::weak_ptr<poll_state> state;
+  const poll_state* key = nullptr;
+  std::uint64_t reported = 0;
+};
+
+struct watchdog_state {
+  explicit watchdog_state(watchdog_options o) : opts{std::move(o)} {}
+
+  watchdog_options opts;
+  std::mutex mu;
+  std::condition_variable cv;
+  bool stopping = false;
+  std::vector<watched> polls;
+  std::atomic<std::uint64_t> stalls{0};
+  std::thread thread;
+
+  void run();
+  void shutdown();
+  auto check(const poll_state& st, watched& w) const -> std::optional<stall_report>;
+
+  static auto state_of(const registry& reg) noexcept -> poll_state* { return reg.state_; }
+};
+
+auto watchdog_state::check(const poll_state& st, watched& w) const -> std::optional<stall_report> {
+  const auto& beat = st.beat;
+  if (beat.in_select.load(std::memory_order_acquire)) {
+    return std::nullopt;
+  }
+  const auto iter = beat.iterations.load(std::memory_order_acquire);
+  if (iter == 0 || iter == w.reported) {
+    return std::nullopt;
+  }
+  // Sample the clock the poll stamped its heartbeat with; a coarse stamp
+  // against a precise now would read up to a jiffy stale.
+  const auto now = loop_clock::sample(beat.mode.load(std::memory_order_relaxed));
+  const auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+  const auto stalled = std::chrono::nanoseconds{now_ns - beat.returned_ns.load(std::memory_order_relaxed)};
+  if (stalled < opts.threshold) {
+    return std::nullopt;
+  }
+
+  stall_report rep;
+  rep.thread = beat.thread.load(std::memory_order_relaxed);
+  rep.iteration = iter;
+  rep.stalled_for = stalled;
+  rep.recorder = st.recorder.get();
+  const auto tok = beat.tok.load(std::memory_order_acquire);
+  const auto tok_ns = beat.tok_ns.load(std::memory_order_relaxed);
+
+  // The loop may have moved on while we read; only this iteration counts.
+  if (beat.in_select.load(std::memory_order_acquire) || beat.iterations.load(std::memory_order_acquire) != iter) {
+    return std::nullopt;
+  }
+  if (tok != heartbeat::k_no_token) {
+    rep.tok = token{static_cast<std::size_t>(tok)};
+    rep.tok_for = std::chrono::nanoseconds{now_ns - tok_ns};
+  }
+  w.reported = iter;
+  return rep;
+}
+
+void watchdog_state::run() {
+  std::vector<stall_report> found;
+  // Keeps reported polls, and so their recorders, alive until the
+  // callbacks have run.
+  std::vector<std::shared_ptr<poll_state>> held;
+  std::unique_lock lock{mu};
+  while (!cv.wait_for(lock, opts.interval, [this] { return stopping; })) {
+    std::erase_if(polls, [](const watched& w) { return w.state.expired(); });
+    for (auto& w : polls) {
+      auto st = w.state.lock();
+      if (st == nullptr) {
+        continue;
+      }
+      if (auto rep = check(*st, w); rep.has_value()) {
+        found.push_back(*rep);
+        held.push_back(std::move(st));
+      }
+    }
+    if (found.empty()) {
+      continue;
+    }
+
+    // Report without the lock so the callback may call `watch`.
+    lock.unlock();
+    for (const auto& rep : found) {
+      stalls.fetch_add(1, std::memory_order_relaxed);
+      if (opts.on_stall) {
+        opts.on_stall(rep);
+      }
+      if (opts.signal != 0 && rep.thread != 0) {
+        (void)::tgkill(::getpid(), static_cast<pid_t>(rep.thread), opts.signal);
+      }
+    }
+    found.clear();
+    held.clear();
+    lock.lock();
+  }
+}
+
+void watchdog_state::shutdown() {
+  {
+    const std::lock_guard lock{mu};
+    stopping = true;
+  }
+  cv.notify_one();
+  if (thread.joinable()) {
+    thread.join();
+  }
+}
+
+}
+
+watchdog::watchdog(std::unique_ptr<detail::watchdog_state> state) noexcept : state_{std::move(state)} {}
+
+watchdog::watchdog(watchdog&&) noexcept = default;
+
+auto watchdog::operator=(watchdog&& other) noexcept -> watchdog& {
+  if (this != &other) {
+    if (state_) {
+      state_->shutdown();
+    }
+    state_ = std::move(other.state_);
+  }
+  return *this;
+}
+
+watchdog::~watchdog() {
+  if (state_) {
+    state_->shutdown();
+  }
+}
+
+auto watchdog::create(watchdog_options opts) -> result<watchdog> {
+  if (opts.threshold <= std::chrono::milliseconds::zero() || opts.interval <= std::chrono::milliseconds::zero()) {
+    return std::unexpected{error{EINVAL}};
+  }
+
+  auto state = std::make_unique<detail::watchdog_state>(std::move(opts));
+  state->thread = std::thread{[s = state.get()] { s->run(); }};
+  return watchdog{std::move(state)};
+}
+
+auto watchdog::watch(const registry& reg) -> void_result {
+  auto* st = detail::watchdog_state::state_of(reg);
+  const std::lock_guard lock{state_->mu};
+  // Drop dead entries first; a new poll may reuse a destroyed one's address.
+  std::erase_if(state_->polls, [](const detail::watched& w) { return w.state.expired(); });
+  if (std::ranges::none_of(state_->polls, [&](const detail::watched& w) { return w.key == st; })) {
+    state_->polls.push_back(detail::watched{.state = st->weak_from_this(), .key = st});
+  }
+  return {};
+}
+
+auto watchdog::unwatch(const registry& reg) -> void_result {
+  const auto* st = detail::watchdog_state::state_of(reg);
+  const std::lock_guard lock{state_->mu};
+  if (std::erase_if(state_->polls, [&](const detail::watched& w) { return w.key == st; }) == 0) {
+    return std::unexpected{error{ENOENT}};
+  }
+  return {};
+}
+
+auto watchdog::stall_count() const noexcept -> std::uint64_t {
+  return state_->stalls.load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <cerrno>
+#include <climits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <tio/sys/detail/work_deque.hpp>
+#include <tio/sys/unix_/futex.hpp>
+#include <tio/work_pool.hpp>
+
+namespace tio {
+
+namespace detail {
+
+void completion_inbox::push(work_item* item) noexcept {
+  work_item* head = head_.load(std::memory_order_relaxed);
+  do {
+    item->next = head;
+  } while (!head_.compare_exchange_weak(
+    head, item, std::memory_order_release, std::memory_order_relaxed
+  ));
+
+  if (head == nullptr) {
+    wakes_.fetch_add(1, std::memory_order_relaxed);
+    [[maybe_unused]] auto r = wake_.wake();
+  }
+}
+
+auto completion_inbox::drain() noexcept -> std::size_t {
+  // Reset the eventfd before taking the list: a push that lands after the
+  // exchange sees an empty list and wakes again.
+  wake_.drain();
+  work_item* head = head_.exchange(nullptr, std::memory_order_acquire);
+
+  work_item* fifo = nullptr;
+  while (head != nullptr) {
+    work_item* next = head->next;
+    head->next = fifo;
+    fifo = head;
+    head = next;
+  }
+
+  std::size_t n = 0;
+  while (fifo != nullptr) {
+    work_item* item = fifo;
+    fifo = item->next;
+    item->next = nullptr;
+    if (item->complete != nullptr) {
+      item->complete(item);
+    }
+    ++n;
+  }
+  return n;
+}
+
+struct worker {
+  work_deque<work_item*> deque;
+  std::thread thread;
+  std::uint64_t rng;
+};
+
+struct pool_state {
+  static constexpr unsigned k_spin_rounds = 64;
+
+  std::vector<std::unique_ptr<worker>> workers;
+
+  std::mutex injector_mu;
+  work_item* injector_head = nullptr;
+  work_item* injector_tail = nullptr;
+  std::atomic<std::size_t> injected{0};
+
+  alignas(64) std::atomic<std::uint32_t> epoch{0};
+  std::atomic<std::uint32_t> sleepers{0};
+  std::atomic<bool> stopping{false};
+
+  std::atomic<std::uint64_t> steals{0};
+  std::atomic<std::uint64_t> parks{0};
+
+  void inject(work_item* item) {
+    item->next = nullptr;
+    const std::lock_guard lock{injector_mu};
+    if (injector_tail == nullptr) {
+      injector_head = item;
+    } else {
+      injector_tail->next = item;
+    }
+    injector_tail = item;
+    injected.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  auto take_injected() -> work_item* {
+    if (injected.load(std::memory_order_relaxed) == 0) {
+      return nullptr;
+    }
+    const std::lock_guard lock{injector_mu};
+    work_item* item = injector_head;
+    if (item != nullptr) {
+      injector_head = item->next;
+      if (injector_head == nullptr) {
+        injector_tail = nullptr;
+      }
+      injected.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  auto steal_for(worker& self) -> work_item* {
+    const auto n = workers.size();
+    self.rng ^= self.rng << 13;
+    self.rng ^= self.rng >> 7;
+    self.rng ^= self.rng << 17;
+    const auto start = static_cast<std::size_t>(self.rng % n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+      worker& victim = *workers[(start + i) % n];
+      if (&victim == &self) {
+        continue;
+      }
+      if (work_item* item = victim.deque.steal()) {
+        steals.fetch_add(1, std::memory_order_relaxed);
+        return item;
+      }
+    }
+    return nullptr;
+  }
+
+  [[nodiscard]] auto has_work() const noexcept -> bool {
+    if (injected.load(std::memory_order_relaxed) != 0) {
+      return true;
+    }
+    for (const auto& w : workers) {
+      if (!w->deque.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // The read-modify-write pairs with the increment in `park`: either the
+  // submitter sees a sleeper and bumps the epoch, or the sleeper's increment
+  // comes later and it sees the new work.
+  void notify() noexcept {
+    if (sleepers.fetch_add(0, std::memory_order_seq_cst) != 0) {
+      epoch.fetch_add(1, std::memory_order_release);
+      sys::unix::futex_wake(epoch, 1);
+    }
+  }
+
+  // Returns false once the pool is stopping and no work is left.
+  auto park() -> bool {
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    const auto e = epoch.load(std::memory_order_seq_cst);
+
+    if (has_work()) {
+      sleepers.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+    if (stopping.load(std::memory_order_acquire)) {
+      sleepers.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    parks.fetch_add(1, std::memory_order_relaxed);
+    sys::unix::futex_wait(epoch, e);
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  void shutdown() {
+    stopping.store(true, std::memory_order_release);
+    epoch.fetch_add(1, std::memory_order_seq_cst);
+    sys::unix::futex_wake(epoch, INT_MAX);
+    for (auto& w : workers) {
+      w->thread.join();
+    }
+  }
+};
+
+namespace {
+
+struct current_worker {
+  pool_state* pool = nullptr;
+  worker* self = nullptr;
+};
+
+thread_local current_worker t_current;
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+void execute(work_item* item) noexcept {
+  completion_inbox* home = item->home;
+  item->run(item);
+  if (home != nullptr) {
+    home->push(item);
+  }
+}
+
+void run_worker(pool_state& p, worker& w) {
+  t_current = {&p, &w};
+
+  unsigned idle = 0;
+  while (true) {
+    work_item* item = w.deque.pop();
+    if (item == nullptr) {
+      item = p.take_injected();
+    }
+    if (item == nullptr) {
+      item = p.steal_for(w);
+    }
+
+    if (item != nullptr) {
+      execute(item);
+      idle = 0;
+      continue;
+    }
+
+    if (idle < pool_state::k_spin_rounds) {
+      ++idle;
+      cpu_relax();
+      continue;
+    }
+
+    if (!p.park()) {
+      break;
+    }
+    idle = 0;
+  }
+
+  t_current = {};
+}
+
+}
+
+}
+
+auto completion_queue::create(registry reg, const token tok) -> result<completion_queue> {
+  auto w = waker::create(std::move(reg), tok);
+  if (!w.has_value()) {
+    return std::unexpected{w.error()};
+  }
+  return completion_queue{std::make_unique<detail::completion_inbox>(std::move(w.value()))};
+}
+
+work_pool::work_pool(std::unique_ptr<detail::pool_state> state) noexcept
+  : state_{std::move(state)} {}
+
+work_pool::work_pool(work_pool&&) noexcept = default;
+
+auto work_pool::operator=(work_pool&& other) noexcept -> work_pool& {
+  if (this != &other) {
+    if (state_) {
+      state_->shutdown();
+    }
+    state_ = std::move(other.state_);
+  }
+  return *this;
+}
+
+work_pool::~work_pool() {
+  if (state_) {
+    state_->shutdown();
+  }
+}
+
+auto work_pool::create(const std::size_t threads) -> result<work_pool> {
+  if (threads == 0) {
+    return std::unexpected{error{EINVAL}};
+  }
+
+  auto state = std::make_unique<detail::pool_state>();
+  state->workers.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    auto w = std::make_unique<detail::worker>();
+    w->rng = 0x9e3779b97f4a7c15ULL * (i + 1);
+    state->workers.push_back(std::move(w));
+  }
+
+  // Start only once the worker vector is final; thieves index into it.
+  for (auto& w : state->workers) {
+    w->thread = std::thread{detail::run_worker, std::ref(*state), std::ref(*w)};
+  }
+  return work_pool{std::move(state)};
+}
+
+void work_pool::submit(work_item* item) {
+  item->home = nullptr;
+  enqueue(item);
+}
+
+void work_pool::submit(work_item* item, completion_queue& cq) {
+  item->home = cq.inbox_.get();
+  enqueue(item);
+}
+
+void work_pool::enqueue(work_item* item) {
+  auto& cur = detail::t_current;
+  if (cur.pool == state_.get()) {
+    cur.self->deque.push(item);
+  } else {
+    state_->inject(item);
+  }
+  state_->notify();
+}
+
+auto work_pool::thread_count() const noexcept -> std::size_t { return state_->workers.size(); }
+
+auto work_pool::steal_count() const noexcept -> std::uint64_t {
+  return state_->steals.load(std::memory_order_relaxed);
+}
+
+auto work_pool::park_count() const noexcept -> std::uint64_t {
+  return state_->parks.load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,107 @@
+# Disassembles the codegen probes and libtio and checks which functions
+# each hot path may call. Invoked by ctest as
+#   cmake -DOBJDUMP=... -DPROBES=<obj> -DLIBRARY=<libtio.a> -P check_codegen.cmake
+#
+# Each rule is "function|callee,callee". A function listed with no
+# callees must contain no call at all; otherwise every call relocation in
+# its body must target one of the listed symbols. Both sides are matched
+# as prefixes of the demangled name.
+
+cmake_policy(SET CMP0007 NEW)
+
+# tcp_stream::read/write stay out of line in libtio: they carry the USDT
+# probes, and TIO_USDT is a private definition of the library, so inlining
+# them into user code would silently drop the probes. A caller therefore
+# makes exactly one call into read, and read itself calls only the
+# syscall wrapper and errno; the two rules below check both halves.
+set(rules
+    "tio_probe_event_is_readable|"
+    "tio_probe_event_token|"
+    "tio_probe_interest_merge|"
+    "tio_probe_events_sum|"
+    "tio_probe_tcp_read|tio::net::tcp_stream::read(,recv,__errno_location"
+    "tio::net::tcp_stream::read(|recv,__errno_location"
+    "tio::net::tcp_stream::write(|send,__errno_location"
+)
+
+function(disassemble file out)
+    execute_process(
+        COMMAND ${OBJDUMP} -d -r -C --no-show-raw-insn ${file}
+        OUTPUT_VARIABLE text
+        RESULT_VARIABLE rc
+    )
+    if (NOT rc EQUAL 0)
+        message(FATAL_ERROR "objdump failed on ${file}")
+    endif ()
+    set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+disassemble(${PROBES} probes_text)
+disassemble(${LIBRARY} library_text)
+string(REPLACE ";" "\;" all_text "${probes_text}\n${library_text}")
+string(REPLACE "\n" ";" lines "${all_text}")
+
+set(failures 0)
+foreach (rule IN LISTS rules)
+    string(REPLACE "|" ";" parts "${rule}")
+    list(GET parts 0 fn)
+    list(LENGTH parts nparts)
+    set(allowed "")
+    if (nparts GREATER 1)
+        list(GET parts 1 allowed)
+        string(REPLACE "," ";" allowed "${allowed}")
+    endif ()
+
+    set(failures_before ${failures})
+    set(inside FALSE)
+    set(found FALSE)
+    set(calls 0)
+    foreach (line IN LISTS lines)
+        if (line MATCHES "^[0-9a-f]+ <(.*)>:$")
+            string(FIND "${CMAKE_MATCH_1}" "${fn}" at)
+            if (at EQUAL 0)
+                set(inside TRUE)
+                set(found TRUE)
+            else ()
+                set(inside FALSE)
+            endif ()
+            continue()
+        endif ()
+        if (NOT inside)
+            continue()
+        endif ()
+
+        if (line MATCHES "\t(call|callq|bl)[ \t]")
+            math(EXPR calls "${calls} + 1")
+        endif ()
+        if (line MATCHES "R_(X86_64_PLT32|X86_64_PC32|AARCH64_CALL26|AARCH64_JUMP26)[ \t]+(.*)$")
+            set(target "${CMAKE_MATCH_2}")
+            set(ok FALSE)
+            foreach (a IN LISTS allowed)
+                string(FIND "${target}" "${a}" at)
+                if (at EQUAL 0)
+                    set(ok TRUE)
+                endif ()
+            endforeach ()
+            # PC32 also covers data references; only flag code symbols.
+            if (NOT ok AND (CMAKE_MATCH_1 MATCHES "PLT32|CALL26|JUMP26"))
+                message(SEND_ERROR "${fn}: unexpected call to ${target}")
+                math(EXPR failures "${failures} + 1")
+            endif ()
+        endif ()
+    endforeach ()
+
+    if (NOT found)
+        message(SEND_ERROR "${fn}: not found in disassembly")
+        math(EXPR failures "${failures} + 1")
+    elseif (allowed STREQUAL "" AND calls GREATER 0)
+        message(SEND_ERROR "${fn}: expected a leaf function, found ${calls} call(s)")
+        math(EXPR failures "${failures} + 1")
+    elseif (failures EQUAL failures_before)
+        message(STATUS "${fn}: ok")
+    endif ()
+endforeach ()
+
+if (failures GREATER 0)
+    message(FATAL_ERROR "${failures} codegen check(s) failed")
+endif ()
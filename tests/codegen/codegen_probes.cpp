@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+// Out-of-line entry points whose disassembly check_codegen.cmake inspects.
+// Each one wraps a single hot accessor; in an optimised build the wrapper
+// must reduce to the raw field access or to a direct call.
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <tio/event.hpp>
+#include <tio/interest.hpp>
+#include <tio/net/tcp_stream.hpp>
+
+extern "C" {
+
+auto tio_probe_event_is_readable(const tio::event& ev) -> bool { return ev.is_readable(); }
+
+auto tio_probe_event_token(const tio::event& ev) -> std::size_t { return ev.tok().value(); }
+
+auto tio_probe_interest_merge(tio::interest a, tio::interest b) -> bool {
+  return (a | b).is_readable();
+}
+
+auto tio_probe_events_sum(const tio::events& evs) -> std::uint64_t {
+  std::uint64_t sum = 0;
+  for (const auto& ev : evs) {
+    sum += ev.is_readable() ? ev.tok().value() : 0;
+  }
+  return sum;
+}
+
+auto tio_probe_tcp_read(const tio::net::tcp_stream& s, std::span<std::byte> buf) -> std::size_t {
+  auto n = s.read(buf);
+  return n.has_value() ? *n : 0;
+}
+
+}
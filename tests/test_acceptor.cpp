@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <tio/event.hpp>
+#include <tio/net/acceptor.hpp>
+#include <tio/net/tcp_listener.hpp>
+#include <tio/net/tcp_stream.hpp>
+#include <tio/poll.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+using tio::events;
+using tio::poll;
+using tio::token;
+using tio::detail::socket_addr;
+using tio::net::acceptor;
+using tio::net::acceptor_inbox;
+using tio::net::acceptor_options;
+using tio::net::placement;
+using tio::net::tcp_listener;
+using tio::net::tcp_stream;
+
+namespace {
+
+constexpr auto k_inbox = token{9};
+
+struct worker {
+  poll p = poll::create().value();
+  events evs{8};
+  acceptor_inbox* inbox = nullptr;
+  std::vector<tcp_stream> conns;
+
+  auto pump(std::chrono::milliseconds timeout) -> std::size_t {
+    EXPECT_TRUE(p.do_poll(evs, timeout).has_value());
+    std::size_t n = 0;
+    for (const auto& ev : evs) {
+      if (ev.tok() == k_inbox) {
+        n += inbox->drain([this](tcp_stream s, const socket_addr&) { conns.push_back(std::move(s)); });
+      }
+    }
+    return n;
+  }
+};
+
+struct fixture {
+  explicit fixture(const acceptor_options& opts, std::size_t workers = 2) {
+    auto l = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+    addr = l.local_addr().value();
+    acc.emplace(acceptor::create(std::move(l), opts).value());
+    ws.resize(workers);
+    for (auto& w : ws) {
+      w.inbox = acc->add_worker(w.p.get_registry(), k_inbox).value();
+    }
+  }
+
+  // Connects one client and runs the acceptor until it has handed it off.
+  void connect_one() {
+    clients.push_back(tcp_stream::connect(addr).value());
+    const auto want = acc->accepted_count() + 1;
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (acc->accepted_count() < want && std::chrono::steady_clock::now() < deadline) {
+      ASSERT_TRUE(acc->run_once(100ms).has_value());
+    }
+    ASSERT_EQ(acc->accepted_count(), want);
+  }
+
+  socket_addr addr;
+  std::optional<acceptor> acc;
+  std::vector<worker> ws;
+  std::vector<tcp_stream> clients;
+};
+
+}
+
+TEST(acceptor_test, round_robin_alternates_workers) {
+  fixture f{acceptor_options{}};
+  for (int i = 0; i < 4; ++i) {
+    f.connect_one();
+  }
+
+  EXPECT_EQ(f.ws[0].pump(100ms), 2u);
+  EXPECT_EQ(f.ws[1].pump(100ms), 2u);
+  EXPECT_EQ(f.ws[0].inbox->live_connections(), 2u);
+}
+
+TEST(acceptor_test, least_connections_prefers_idle_worker) {
+  fixture f{acceptor_options{.place = placement::least_connections}};
+
+  f.connect_one();
+  f.connect_one();
+  EXPECT_EQ(f.ws[0].pump(100ms), 1u);
+  EXPECT_EQ(f.ws[1].pump(100ms), 1u);
+
+  f.ws[1].conns.clear();
+  f.ws[1].inbox->connection_closed();
+
+  f.connect_one();
+  EXPECT_EQ(f.ws[1].pump(100ms), 1u);
+  EXPECT_EQ(f.ws[0].inbox->live_connections(), 1u);
+  EXPECT_EQ(f.ws[1].inbox->live_connections(), 1u);
+}
+
+TEST(acceptor_test, incoming_cpu_uses_socket_cpu) {
+  fixture f{acceptor_options{.place = placement::incoming_cpu}};
+  f.connect_one();
+
+  std::size_t got = 0;
+  for (auto& w : f.ws) {
+    got += w.pump(0ms);
+  }
+  EXPECT_EQ(got, 1u);
+
+  const auto& s = f.ws[0].conns.empty() ? f.ws[1].conns.front() : f.ws[0].conns.front();
+  const auto cpu = s.incoming_cpu();
+  ASSERT_TRUE(cpu.has_value());
+  EXPECT_EQ(f.ws[static_cast<std::size_t>(*cpu) % 2].conns.size(), 1u);
+}
+
+TEST(acceptor_test, batch_wakes_each_worker_once) {
+  fixture f{acceptor_options{}};
+
+  for (int i = 0; i < 8; ++i) {
+    f.clients.push_back(tcp_stream::connect(f.addr).value());
+  }
+  std::this_thread::sleep_for(20ms);
+  ASSERT_EQ(f.acc->accept_batch().value(), 8u);
+
+  EXPECT_EQ(f.ws[0].inbox->wake_count(), 1u);
+  EXPECT_EQ(f.ws[1].inbox->wake_count(), 1u);
+  EXPECT_EQ(f.ws[0].pump(100ms), 4u);
+  EXPECT_EQ(f.ws[1].pump(100ms), 4u);
+}
+
+TEST(acceptor_test, full_inboxes_stall_instead_of_dropping) {
+  fixture f{acceptor_options{.queue_capacity = 1}, 1};
+
+  f.clients.push_back(tcp_stream::connect(f.addr).value());
+  f.clients.push_back(tcp_stream::connect(f.addr).value());
+  std::this_thread::sleep_for(20ms);
+
+  ASSERT_EQ(f.acc->accept_batch().value(), 1u);
+  EXPECT_TRUE(f.acc->is_stalled());
+
+  EXPECT_EQ(f.ws[0].pump(100ms), 1u);
+  ASSERT_EQ(f.acc->accept_batch().value(), 1u);
+  EXPECT_FALSE(f.acc->is_stalled());
+  EXPECT_EQ(f.ws[0].pump(100ms), 1u);
+}
+
+TEST(acceptor_test, full_batch_polls_again_without_waiting) {
+  fixture f{acceptor_options{.max_batch = 2}, 1};
+  for (int i = 0; i < 3; ++i) {
+    f.clients.push_back(tcp_stream::connect(f.addr).value());
+  }
+  std::this_thread::sleep_for(20ms);
+  ASSERT_EQ(f.acc->accept_batch().value(), 2u);
+
+  // The listener will not fire again for the queued connection, so the
+  // next round must poll with a zero timeout and accept it straight away.
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(f.acc->run_once(5s).has_value());
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+  EXPECT_EQ(f.acc->accepted_count(), 3u);
+  EXPECT_EQ(f.ws[0].pump(100ms), 3u);
+}
+
+TEST(acceptor_test, fd_exhaustion_is_retried) {
+  fixture f{acceptor_options{.resource_retry = 5ms}, 1};
+  f.clients.push_back(tcp_stream::connect(f.addr).value());
+  f.clients.push_back(tcp_stream::connect(f.addr).value());
+  std::this_thread::sleep_for(20ms);
+
+  // Cap the fd table just above the lowest free descriptor so the next
+  // accept() fails with EMFILE.
+  rlimit saved{};
+  ASSERT_EQ(::getrlimit(RLIMIT_NOFILE, &saved), 0);
+  const int lowest = ::dup(0);
+  ASSERT_GE(lowest, 0);
+  ::close(lowest);
+  rlimit tight = saved;
+  tight.rlim_cur = static_cast<rlim_t>(lowest);
+  ASSERT_EQ(::setrlimit(RLIMIT_NOFILE, &tight), 0);
+
+  const auto starved = f.acc->run_once(0ms);
+  const auto errors = f.acc->resource_errors();
+  const auto accepted = f.acc->accepted_count();
+  ASSERT_EQ(::setrlimit(RLIMIT_NOFILE, &saved), 0);
+
+  ASSERT_TRUE(starved.has_value());
+  EXPECT_GE(errors, 1u);
+  EXPECT_EQ(accepted, 0u);
+
+  // No new connection arrives, so only the retry can drain the backlog.
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (f.acc->accepted_count() < 2 && std::chrono::steady_clock::now() < deadline) {
+    ASSERT_TRUE(f.acc->run_once(100ms).has_value());
+  }
+  EXPECT_EQ(f.acc->accepted_count(), 2u);
+  EXPECT_EQ(f.ws[0].pump(100ms), 2u);
+}
+
+TEST(acceptor_test, acceptor_thread_feeds_worker_polls) {
+  fixture f{acceptor_options{}, 3};
+  std::jthread t{[&f](std::stop_token st) { ASSERT_TRUE(f.acc->run(st).has_value()); }};
+
+  constexpr std::size_t n = 60;
+  for (std::size_t i = 0; i < n; ++i) {
+    f.clients.push_back(tcp_stream::connect(f.addr).value());
+  }
+
+  std::size_t got = 0;
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (got < n && std::chrono::steady_clock::now() < deadline) {
+    for (auto& w : f.ws) {
+      got += w.pump(10ms);
+    }
+  }
+  t.request_stop();
+  t.join();
+
+  EXPECT_EQ(got, n);
+  for (auto& w : f.ws) {
+    EXPECT_EQ(w.conns.size(), n / 3);
+  }
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <chrono>
+#include <thread>
+
+#include <tio/clock.hpp>
+#include <tio/poll.hpp>
+
+#include <gtest/gtest.h>
+
+using tio::clock_mode;
+using tio::events;
+using tio::loop_clock;
+using tio::poll;
+using tio::poll_options;
+
+TEST(clock_test, sample_matches_steady_clock) {
+  const auto before = std::chrono::steady_clock::now();
+  const auto sampled = loop_clock::sample(clock_mode::precise);
+  const auto after = std::chrono::steady_clock::now();
+
+  EXPECT_LE(before, sampled);
+  EXPECT_LE(sampled, after);
+}
+
+TEST(clock_test, coarse_is_close_to_precise) {
+  const auto precise = loop_clock::sample(clock_mode::precise);
+  const auto coarse = loop_clock::sample(clock_mode::coarse);
+
+  const auto diff = precise > coarse ? precise - coarse : coarse - precise;
+  EXPECT_LT(diff, std::chrono::milliseconds{100});
+}
+
+TEST(clock_test, now_is_cached_until_update) {
+  loop_clock c;
+  const auto t0 = c.now();
+  std::this_thread::sleep_for(std::chrono::milliseconds{5});
+  EXPECT_EQ(c.now(), t0);
+
+  const auto t1 = c.update();
+  EXPECT_GT(t1, t0);
+  EXPECT_EQ(c.now(), t1);
+}
+
+TEST(clock_test, poll_samples_clock_on_return) {
+  auto p = poll::create().value();
+  events evs{16};
+
+  const auto t0 = p.loop_now();
+  p.do_poll(evs, std::chrono::milliseconds{20}).value();
+  const auto t1 = p.loop_now();
+
+  EXPECT_GE(t1 - t0, std::chrono::milliseconds{20});
+  EXPECT_EQ(p.loop_now(), t1);
+}
+
+TEST(clock_test, poll_coarse_mode) {
+  auto p = poll::create(poll_options{.clock = clock_mode::coarse}).value();
+  EXPECT_EQ(p.clock().mode(), clock_mode::coarse);
+
+  events evs{16};
+  const auto t0 = p.loop_now();
+  p.do_poll(evs, std::chrono::milliseconds{30}).value();
+  EXPECT_GE(p.loop_now(), t0);
+
+  p.set_clock_mode(clock_mode::precise);
+  EXPECT_EQ(p.clock().mode(), clock_mode::precise);
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <tio/clock.hpp>
+#include <tio/event.hpp>
+#include <tio/net/connection_manager.hpp>
+#include <tio/net/tcp_listener.hpp>
+#include <tio/net/tcp_stream.hpp>
+#include <tio/poll.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+using tio::events;
+using tio::loop_clock;
+using tio::poll;
+using tio::token;
+using tio::detail::socket_addr;
+using tio::net::close_reason;
+using tio::net::connection_manager;
+using tio::net::connection_options;
+using tio::net::tcp_listener;
+using tio::net::tcp_stream;
+
+namespace {
+
+constexpr auto k_listener = token{1};
+
+struct fixture {
+  explicit fixture(const connection_options& opts) {
+    auto l = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+    addr = l.local_addr().value();
+    mgr.emplace(connection_manager::create(p.get_registry(), std::move(l), k_listener, opts).value());
+  }
+
+  // Connects `n` clients and accepts until the manager holds `want`.
+  auto connect(std::size_t n, std::size_t want) -> std::vector<token> {
+    for (std::size_t i = 0; i < n; ++i) {
+      clients.push_back(tcp_stream::connect(addr).value());
+    }
+    std::vector<token> toks;
+    for (int round = 0; round < 50 && mgr->size() < want; ++round) {
+      EXPECT_TRUE(p.do_poll(evs, 100ms).has_value());
+      for (const auto& ev : evs) {
+        if (ev.tok() == k_listener) {
+          EXPECT_TRUE(mgr->accept_ready(t0, [&](token t, tcp_stream&) { toks.push_back(t); })
+                        .has_value());
+        }
+      }
+    }
+    EXPECT_EQ(mgr->size(), want);
+    return toks;
+  }
+
+  poll p = poll::create().value();
+  events evs{16};
+  socket_addr addr{};
+  std::optional<connection_manager> mgr;
+  std::vector<tcp_stream> clients;
+  loop_clock::time_point t0 = loop_clock::sample(tio::clock_mode::precise);
+};
+
+auto sees_eof(tcp_stream& s) -> bool {
+  std::array<std::byte, 16> buf{};
+  for (int i = 0; i < 50; ++i) {
+    auto r = s.read(buf);
+    if (r.has_value()) {
+      return *r == 0;
+    }
+    if (!r.error().is_would_block()) {
+      return true;
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+  return false;
+}
+
+auto opts(std::size_t max = 16) -> connection_options {
+  connection_options o;
+  o.max_connections = max;
+  o.idle_timeout = 1000ms;
+  o.tick = 100ms;
+  o.wheel_slots = 64;
+  return o;
+}
+
+}
+
+TEST(connection_manager_test, accepts_into_slots) {
+  fixture f{opts()};
+  const auto toks = f.connect(2, 2);
+  ASSERT_EQ(toks.size(), 2u);
+  EXPECT_NE(toks[0], toks[1]);
+  EXPECT_NE(f.mgr->find(toks[0]), nullptr);
+  EXPECT_EQ(f.mgr->find(token{999}), nullptr);
+  EXPECT_EQ(f.mgr->capacity(), 16u);
+}
+
+TEST(connection_manager_test, idle_connection_expires) {
+  fixture f{opts()};
+  const auto toks = f.connect(1, 1);
+  ASSERT_EQ(toks.size(), 1u);
+
+  EXPECT_EQ(f.mgr->expire(f.t0 + 500ms), 0u);
+  f.mgr->touch(toks[0], f.t0 + 800ms);
+  EXPECT_EQ(f.mgr->expire(f.t0 + 1500ms), 0u);
+
+  std::vector<close_reason> reasons;
+  EXPECT_EQ(f.mgr->expire(f.t0 + 2000ms, [&](token, close_reason r) { reasons.push_back(r); }), 1u);
+  ASSERT_EQ(reasons.size(), 1u);
+  EXPECT_EQ(reasons[0], close_reason::idle);
+  EXPECT_EQ(f.mgr->size(), 0u);
+  EXPECT_EQ(f.mgr->find(toks[0]), nullptr);
+  EXPECT_TRUE(sees_eof(f.clients[0]));
+}
+
+TEST(connection_manager_test, busy_connection_does_not_idle) {
+  fixture f{opts()};
+  const auto toks = f.connect(1, 1);
+  f.mgr->set_busy(toks[0], true);
+  EXPECT_EQ(f.mgr->expire(f.t0 + 5s), 0u);
+
+  f.mgr->set_busy(toks[0], false);
+  EXPECT_EQ(f.mgr->expire(f.t0 + 10s), 1u);
+}
+
+TEST(connection_manager_test, cap_pauses_and_close_resumes) {
+  fixture f{opts(2)};
+  const auto toks = f.connect(3, 2);
+  ASSERT_EQ(toks.size(), 2u);
+  EXPECT_TRUE(f.mgr->is_paused());
+
+  f.mgr->close(toks[0]);
+  EXPECT_FALSE(f.mgr->is_paused());
+  EXPECT_EQ(f.mgr->size(), 1u);
+
+  // The queued third client is reported once the listener is re-added.
+  const auto more = f.connect(0, 2);
+  ASSERT_EQ(more.size(), 1u);
+  EXPECT_EQ(more[0], toks[0]);
+  EXPECT_TRUE(f.mgr->is_paused());
+}
+
+TEST(connection_manager_test, drain_waits_for_busy_connections) {
+  fixture f{opts()};
+  const auto toks = f.connect(2, 2);
+  ASSERT_EQ(toks.size(), 2u);
+  f.mgr->set_busy(toks[1], true);
+
+  f.mgr->begin_drain(f.t0, 5s);
+  EXPECT_TRUE(f.mgr->is_draining());
+  EXPECT_TRUE(f.mgr->is_paused());
+
+  std::vector<token> closed;
+  auto on_close = [&](token t, close_reason r) {
+    EXPECT_EQ(r, close_reason::drained);
+    closed.push_back(t);
+  };
+  EXPECT_EQ(f.mgr->expire(f.t0 + 100ms, on_close), 1u);
+  ASSERT_EQ(closed.size(), 1u);
+  EXPECT_EQ(closed[0], toks[0]);
+  EXPECT_FALSE(f.mgr->is_drained());
+
+  f.mgr->set_busy(toks[1], false);
+  EXPECT_EQ(f.mgr->expire(f.t0 + 200ms, on_close), 1u);
+  EXPECT_TRUE(f.mgr->is_drained());
+  EXPECT_TRUE(f.mgr->is_paused());
+}
+
+TEST(connection_manager_test, drain_deadline_closes_busy_connections) {
+  fixture f{opts()};
+  const auto toks = f.connect(1, 1);
+  f.mgr->set_busy(toks[0], true);
+  f.mgr->begin_drain(f.t0, 500ms);
+
+  EXPECT_EQ(f.mgr->expire(f.t0 + 300ms), 0u);
+  EXPECT_EQ(f.mgr->expire(f.t0 + 700ms), 1u);
+  EXPECT_TRUE(f.mgr->is_drained());
+}
+
+TEST(connection_manager_test, next_timeout_tracks_wheel) {
+  fixture f{opts()};
+  EXPECT_FALSE(f.mgr->next_timeout(f.t0).has_value());
+  f.connect(1, 1);
+  const auto t = f.mgr->next_timeout(f.t0);
+  ASSERT_TRUE(t.has_value());
+  EXPECT_GT(*t, 0ms);
+  EXPECT_LE(*t, 1100ms);
+}
+
+TEST(connection_manager_test, next_timeout_counts_from_now) {
+  fixture f{opts()};
+  f.connect(1, 1);
+  // Idle deadline t0 + 1000ms lands in the bucket for tick 11.
+  EXPECT_EQ(f.mgr->next_timeout(f.t0), 1100ms);
+  EXPECT_EQ(f.mgr->next_timeout(f.t0 + 450ms), 650ms);
+  EXPECT_EQ(f.mgr->next_timeout(f.t0 + 2s), 0ms);
+
+  EXPECT_EQ(f.mgr->expire(f.t0 + 520ms), 0u);
+  EXPECT_EQ(f.mgr->next_timeout(f.t0 + 530ms), 570ms);
+}
+
+TEST(connection_manager_test, rejects_zero_capacity) {
+  auto l = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+  auto p = poll::create().value();
+  EXPECT_FALSE(connection_manager::create(p.get_registry(), std::move(l), k_listener, opts(0))
+                 .has_value());
+}
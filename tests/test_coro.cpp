@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <tio/coro/async_source.hpp>
+#include <tio/coro/reactor.hpp>
+#include <tio/coro/task.hpp>
+#include <tio/net/tcp_listener.hpp>
+#include <tio/net/tcp_stream.hpp>
+#include <tio/net/udp_socket.hpp>
+#include <tio/unix/unix_stream.hpp>
+
+#include <gtest/gtest.h>
+
+using tio::result;
+using tio::coro::async_source;
+using tio::coro::reactor;
+using tio::coro::task;
+using tio::coro::detail::frame_pool;
+using tio::detail::socket_addr;
+using tio::net::tcp_listener;
+using tio::net::tcp_stream;
+using tio::net::udp_socket;
+using tio::unix_::unix_stream;
+
+namespace {
+
+auto as_bytes(const char* s) -> std::span<const std::byte> {
+  return std::as_bytes(std::span{s, std::strlen(s)});
+}
+
+auto to_string(std::span<const std::byte> b) -> std::string {
+  return {reinterpret_cast<const char*>(b.data()), b.size()};
+}
+
+auto answer() -> task<int> { co_return 42; }
+
+auto add_answers() -> task<int> {
+  const int a = co_await answer();
+  const int b = co_await answer();
+  co_return a + b;
+}
+
+auto read_exact(async_source<unix_stream>& s, std::size_t n) -> task<std::string> {
+  std::string out;
+  std::array<std::byte, 64> buf{};
+  while (out.size() < n) {
+    auto r = co_await s.async_read(buf);
+    if (!r.has_value() || *r == 0) {
+      break;
+    }
+    out += to_string(std::span{buf}.first(*r));
+  }
+  co_return out;
+}
+
+auto echo_once(async_source<unix_stream>& s) -> task<void> {
+  std::array<std::byte, 64> buf{};
+  auto n = (co_await s.async_read(buf)).value();
+  (co_await s.async_write(std::span{buf}.first(n))).value();
+}
+
+auto ping(async_source<unix_stream>& s, std::string* out) -> task<void> {
+  (co_await s.async_write(as_bytes("ping"))).value();
+  *out = co_await read_exact(s, 4);
+}
+
+}
+
+TEST(coro_test, task_chain_completes_synchronously) {
+  auto rx = reactor::create().value();
+  auto r = rx.block_on(add_answers());
+  ASSERT_TRUE(r.has_value());
+  EXPECT_EQ(*r, 84);
+  EXPECT_EQ(rx.live_tasks(), 0u);
+}
+
+TEST(coro_test, unix_stream_ping_pong) {
+  auto rx = reactor::create().value();
+  auto [a, b] = unix_stream::pair().value();
+  auto client = async_source<unix_stream>::attach(rx, std::move(a)).value();
+  auto server = async_source<unix_stream>::attach(rx, std::move(b)).value();
+
+  std::string reply;
+  rx.spawn(echo_once(server));
+  rx.spawn(ping(client, &reply));
+  EXPECT_EQ(rx.live_tasks(), 2u);
+
+  rx.run().value();
+  EXPECT_EQ(reply, "ping");
+  EXPECT_EQ(rx.live_tasks(), 0u);
+}
+
+TEST(coro_test, tcp_accept_and_read) {
+  auto rx = reactor::create().value();
+  auto l = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+  const auto addr = l.local_addr().value();
+  auto listener = async_source<tcp_listener>::attach(rx, std::move(l)).value();
+
+  auto server = [](reactor& rx, async_source<tcp_listener>& listener) -> task<std::string> {
+    auto [stream, peer] = (co_await listener.async_accept()).value();
+    auto conn = async_source<tcp_stream>::attach(rx, std::move(stream)).value();
+    std::array<std::byte, 64> buf{};
+    auto n = (co_await conn.async_read(buf)).value();
+    co_return to_string(std::span{buf}.first(n));
+  };
+
+  auto client = [](reactor& rx, socket_addr addr) -> task<void> {
+    auto conn = async_source<tcp_stream>::attach(rx, tcp_stream::connect(addr).value()).value();
+    (co_await conn.async_write(as_bytes("hello"))).value();
+  };
+
+  std::string got;
+  auto collect = [](task<std::string> t, std::string* out) -> task<void> { *out = co_await std::move(t); };
+  rx.spawn(collect(server(rx, listener), &got));
+  rx.spawn(client(rx, addr));
+  rx.run().value();
+
+  EXPECT_EQ(got, "hello");
+}
+
+TEST(coro_test, udp_recv_from) {
+  auto rx = reactor::create().value();
+  auto recv_sock = udp_socket::bind(socket_addr::ipv4_loopback(0)).value();
+  const auto addr = recv_sock.local_addr().value();
+  auto receiver = async_source<udp_socket>::attach(rx, std::move(recv_sock)).value();
+  auto sender = async_source<udp_socket>::attach(
+    rx, udp_socket::bind(socket_addr::ipv4_loopback(0)).value()
+  ).value();
+
+  auto recv = [](async_source<udp_socket>& s) -> task<std::size_t> {
+    std::array<std::byte, 64> buf{};
+    auto [n, from] = (co_await s.async_recv_from(buf)).value();
+    co_return n;
+  };
+
+  auto send = [](async_source<udp_socket>& s, socket_addr to) -> task<void> {
+    (co_await s.async_send_to(as_bytes("datagram"), to)).value();
+  };
+
+  std::size_t n = 0;
+  auto collect = [](task<std::size_t> t, std::size_t* out) -> task<void> { *out = co_await std::move(t); };
+  rx.spawn(collect(recv(receiver), &n));
+  rx.spawn(send(sender, addr));
+  rx.run().value();
+
+  EXPECT_EQ(n, 8u);
+}
+
+TEST(coro_test, read_sees_eof_on_peer_close) {
+  auto rx = reactor::create().value();
+  auto [a, b] = unix_stream::pair().value();
+  auto reader = async_source<unix_stream>::attach(rx, std::move(a)).value();
+
+  auto r = [](async_source<unix_stream>& s) -> task<result<std::size_t>> {
+    std::array<std::byte, 16> buf{};
+    co_return co_await s.async_read(buf);
+  };
+
+  std::optional<result<std::size_t>> got;
+  auto collect = [](task<result<std::size_t>> t, std::optional<result<std::size_t>>* out) -> task<void> {
+    out->emplace(co_await std::move(t));
+  };
+  rx.spawn(collect(r(reader), &got));
+  EXPECT_FALSE(got.has_value());
+
+  { auto drop = std::move(b); }
+  rx.run().value();
+
+  ASSERT_TRUE(got.has_value());
+  ASSERT_TRUE(got->has_value());
+  EXPECT_EQ(**got, 0u);
+}
+
+TEST(coro_test, destroying_source_cancels_pending_read) {
+  auto rx = reactor::create().value();
+  auto [a, b] = unix_stream::pair().value();
+  std::optional<async_source<unix_stream>> reader{async_source<unix_stream>::attach(rx, std::move(a)).value()};
+
+  auto r = [](async_source<unix_stream>& s) -> task<result<std::size_t>> {
+    std::array<std::byte, 16> buf{};
+    co_return co_await s.async_read(buf);
+  };
+
+  std::optional<result<std::size_t>> got;
+  auto collect = [](task<result<std::size_t>> t, std::optional<result<std::size_t>>* out) -> task<void> {
+    out->emplace(co_await std::move(t));
+  };
+  rx.spawn(collect(r(*reader), &got));
+  EXPECT_EQ(rx.live_tasks(), 1u);
+
+  reader.reset();
+  rx.run().value();
+
+  ASSERT_TRUE(got.has_value());
+  ASSERT_FALSE(got->has_value());
+  EXPECT_EQ(got->error().code(), ECANCELED);
+  EXPECT_EQ(rx.live_tasks(), 0u);
+}
+
+TEST(coro_test, moving_source_keeps_pending_read) {
+  auto rx = reactor::create().value();
+  auto [a, b] = unix_stream::pair().value();
+  std::optional<async_source<unix_stream>> first{async_source<unix_stream>::attach(rx, std::move(a)).value()};
+
+  auto r = [](async_source<unix_stream>& s) -> task<result<std::size_t>> {
+    std::array<std::byte, 16> buf{};
+    co_return co_await s.async_read(buf);
+  };
+
+  std::optional<result<std::size_t>> got;
+  auto collect = [](task<result<std::size_t>> t, std::optional<result<std::size_t>>* out) -> task<void> {
+    out->emplace(co_await std::move(t));
+  };
+  rx.spawn(collect(r(*first), &got));
+  ASSERT_FALSE(got.has_value());
+
+  // The parked read must retry on the moved-to source, not the old one.
+  auto second = std::move(*first);
+  first.reset();
+  const std::array<std::byte, 3> msg{};
+  ASSERT_EQ(b.write(msg).value(), msg.size());
+  rx.run().value();
+
+  ASSERT_TRUE(got.has_value());
+  ASSERT_TRUE(got->has_value());
+  EXPECT_EQ(**got, msg.size());
+  EXPECT_GE(second.get().raw_fd(), 0);
+}
+
+TEST(coro_test, second_reader_gets_ebusy) {
+  auto rx = reactor::create().value();
+  auto [a, b] = unix_stream::pair().value();
+  auto reader = async_source<unix_stream>::attach(rx, std::move(a)).value();
+
+  auto r = [](async_source<unix_stream>& s) -> task<result<std::size_t>> {
+    std::array<std::byte, 16> buf{};
+    co_return co_await s.async_read(buf);
+  };
+
+  std::optional<result<std::size_t>> first;
+  std::optional<result<std::size_t>> second;
+  auto collect = [](task<result<std::size_t>> t, std::optional<result<std::size_t>>* out) -> task<void> {
+    out->emplace(co_await std::move(t));
+  };
+  rx.spawn(collect(r(reader), &first));
+  rx.spawn(collect(r(reader), &second));
+
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(second->error().code(), EBUSY);
+  EXPECT_FALSE(first.has_value());
+
+  ASSERT_TRUE(b.write(as_bytes("x")).has_value());
+  rx.run().value();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(first->value(), 1u);
+}
+
+TEST(coro_test, frames_are_recycled) {
+  auto rx = reactor::create().value();
+  auto& pool = frame_pool::local();
+
+  (void)rx.block_on(add_answers());
+  const auto warm = pool.allocated_blocks();
+
+  for (int i = 0; i < 100; ++i) {
+    (void)rx.block_on(add_answers());
+  }
+  EXPECT_EQ(pool.allocated_blocks(), warm);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <tio/dispatch.hpp>
+
+#include <gtest/gtest.h>
+
+using tio::batch_dispatcher;
+using tio::event;
+using tio::events;
+using tio::token;
+
+namespace {
+
+struct conn_state {
+  std::size_t id;
+  int kind;
+  int hits;
+};
+
+void fill(events& evs, std::initializer_list<std::uint64_t> toks) {
+  std::size_t i = 0;
+  for (const auto t : toks) {
+    evs.raw_buf()[i].data.u64 = t;
+    evs.raw_buf()[i].events = EPOLLIN;
+    ++i;
+  }
+  evs.set_len(i);
+}
+
+}
+
+TEST(dispatch_test, runs_handlers_in_event_order) {
+  std::array<conn_state, 4> states{{{0, 0, 0}, {1, 0, 0}, {2, 0, 0}, {3, 0, 0}}};
+  events evs{8};
+  fill(evs, {2, 0, 3, 1});
+
+  batch_dispatcher<conn_state> d{8};
+  std::vector<std::size_t> seen;
+  d.dispatch(
+    evs,
+    [&](token t) { return &states[t.value()]; },
+    [&](const event& ev, conn_state& st) {
+      EXPECT_EQ(ev.tok().value(), st.id);
+      EXPECT_TRUE(ev.is_readable());
+      ++st.hits;
+      seen.push_back(st.id);
+    }
+  );
+
+  EXPECT_EQ(seen, (std::vector<std::size_t>{2, 0, 3, 1}));
+  for (const auto& st : states) {
+    EXPECT_EQ(st.hits, 1);
+  }
+}
+
+TEST(dispatch_test, skips_unresolved_tokens) {
+  std::array<conn_state, 2> states{{{0, 0, 0}, {1, 0, 0}}};
+  events evs{8};
+  fill(evs, {0, 99, 1});
+
+  batch_dispatcher<conn_state> d{8};
+  int calls = 0;
+  d.dispatch(
+    evs,
+    [&](token t) -> conn_state* { return t.value() < states.size() ? &states[t.value()] : nullptr; },
+    [&](const event&, conn_state&) { ++calls; }
+  );
+
+  EXPECT_EQ(calls, 2);
+}
+
+TEST(dispatch_test, batch_larger_than_capacity) {
+  std::array<conn_state, 5> states{{{0, 0, 0}, {1, 0, 0}, {2, 0, 0}, {3, 0, 0}, {4, 0, 0}}};
+  events evs{8};
+  fill(evs, {0, 1, 2, 3, 4});
+
+  batch_dispatcher<conn_state> d{2, 1};
+  std::vector<std::size_t> seen;
+  d.dispatch(
+    evs,
+    [&](token t) { return &states[t.value()]; },
+    [&](const event&, conn_state& st) { seen.push_back(st.id); }
+  );
+
+  EXPECT_EQ(seen, (std::vector<std::size_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(dispatch_test, grouped_is_stable_by_kind) {
+  std::array<conn_state, 5> states{{{0, 1, 0}, {1, 0, 0}, {2, 1, 0}, {3, 2, 0}, {4, 0, 0}}};
+  events evs{8};
+  fill(evs, {0, 1, 2, 3, 4});
+
+  batch_dispatcher<conn_state> d{8};
+  std::vector<std::size_t> seen;
+  d.dispatch_grouped<3>(
+    evs,
+    [](const event&, const conn_state* st) { return st->kind; },
+    [&](token t) { return &states[t.value()]; },
+    [&](const event&, conn_state& st) { seen.push_back(st.id); }
+  );
+
+  EXPECT_EQ(seen, (std::vector<std::size_t>{1, 4, 0, 2, 3}));
+}
+
+TEST(dispatch_test, grouped_clamps_out_of_range_kinds) {
+  std::array<conn_state, 4> states{{{0, 7, 0}, {1, 0, 0}, {2, -1, 0}, {3, 1, 0}}};
+  events evs{8};
+  fill(evs, {0, 1, 2, 3});
+
+  batch_dispatcher<conn_state> d{8};
+  std::vector<std::size_t> seen;
+  d.dispatch_grouped<2>(
+    evs,
+    [](const event&, const conn_state* st) { return st->kind; },
+    [&](token t) { return &states[t.value()]; },
+    [&](const event&, conn_state& st) { seen.push_back(st.id); }
+  );
+
+  EXPECT_EQ(seen, (std::vector<std::size_t>{1, 0, 2, 3}));
+}
+
+TEST(dispatch_test, grouped_by_enum) {
+  enum class role : std::uint8_t { listener, stream };
+  std::array<conn_state, 3> states{{{0, 1, 0}, {1, 0, 0}, {2, 1, 0}}};
+  events evs{8};
+  fill(evs, {0, 1, 2});
+
+  batch_dispatcher<conn_state> d{8};
+  std::vector<std::size_t> seen;
+  d.dispatch_grouped<2>(
+    evs,
+    [](const event&, const conn_state* st) { return st->kind == 0 ? role::listener : role::stream; },
+    [&](token t) { return &states[t.value()]; },
+    [&](const event&, conn_state& st) { seen.push_back(st.id); }
+  );
+
+  EXPECT_EQ(seen, (std::vector<std::size_t>{1, 0, 2}));
+}
+
+TEST(dispatch_test, empty_batch) {
+  events evs{8};
+  batch_dispatcher<conn_state> d{8};
+  int calls = 0;
+  d.dispatch(
+    evs,
+    [](token) -> conn_state* { return nullptr; },
+    [&](const event&, conn_state&) { ++calls; }
+  );
+  EXPECT_EQ(calls, 0);
+}
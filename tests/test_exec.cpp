@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+
+#include <tio/coro/async_source.hpp>
+#include <tio/coro/reactor.hpp>
+#include <tio/exec/algorithms.hpp>
+#include <tio/exec/io.hpp>
+#include <tio/exec/scheduler.hpp>
+#include <tio/net/tcp_listener.hpp>
+#include <tio/net/tcp_stream.hpp>
+#include <tio/unix/unix_stream.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+using tio::coro::async_source;
+using tio::coro::reactor;
+using tio::detail::socket_addr;
+using tio::exec::scheduler;
+using tio::exec::sync_wait;
+using tio::exec::then;
+using tio::net::tcp_listener;
+using tio::net::tcp_stream;
+using tio::unix_::unix_stream;
+
+namespace {
+
+auto as_bytes(const char* s) -> std::span<const std::byte> {
+  return std::as_bytes(std::span{s, std::strlen(s)});
+}
+
+struct flag_receiver {
+  std::atomic<bool>* done;
+
+  void set_value() noexcept { done->store(true); }
+
+  void set_error(const tio::error&) noexcept {}
+
+  void set_stopped() noexcept {}
+};
+
+}
+
+TEST(exec_test, schedule_completes_on_loop) {
+  auto rx = reactor::create().value();
+  const scheduler sch{rx};
+
+  auto r = sync_wait(rx, sch.schedule() | then([] { return 7; }));
+  ASSERT_TRUE(r.has_value());
+  ASSERT_TRUE(r->has_value());
+  EXPECT_EQ(**r, 7);
+}
+
+TEST(exec_test, schedule_from_other_thread_wakes_loop) {
+  auto rx = reactor::create().value();
+  const scheduler sch{rx};
+
+  std::atomic<bool> done{false};
+  auto op = sch.schedule().connect(flag_receiver{&done});
+  std::thread t{[&] { op.start(); }};
+
+  while (!done.load()) {
+    rx.run_once(5s).value();
+  }
+  t.join();
+  EXPECT_TRUE(done.load());
+}
+
+TEST(exec_test, schedule_after_waits_for_deadline) {
+  auto rx = reactor::create().value();
+  const scheduler sch{rx};
+
+  const auto start = std::chrono::steady_clock::now();
+  auto r = sync_wait(rx, sch.schedule_after(20ms));
+  ASSERT_TRUE(r.has_value());
+  EXPECT_TRUE(r->has_value());
+  EXPECT_GE(std::chrono::steady_clock::now() - start, 20ms);
+  EXPECT_EQ(rx.timer_count(), 0u);
+}
+
+TEST(exec_test, schedule_after_is_stopped_from_other_thread) {
+  auto rx = reactor::create().value();
+  const scheduler sch{rx};
+
+  std::stop_source ss;
+  std::thread t{[&] {
+    std::this_thread::sleep_for(10ms);
+    ss.request_stop();
+  }};
+
+  const auto start = std::chrono::steady_clock::now();
+  auto r = sync_wait(rx, sch.schedule_after(10s), ss.get_token());
+  t.join();
+
+  EXPECT_FALSE(r.has_value());
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+  EXPECT_EQ(rx.timer_count(), 0u);
+}
+
+TEST(exec_test, read_then_transform) {
+  auto rx = reactor::create().value();
+  auto [a, b] = unix_stream::pair().value();
+  auto src = async_source<unix_stream>::attach(rx, std::move(a)).value();
+  ASSERT_TRUE(b.write(as_bytes("hello")).has_value());
+
+  std::array<std::byte, 64> buf{};
+  auto r = sync_wait(rx, tio::exec::async_read(src, buf) | then([](std::size_t n) { return n * 2; }));
+  ASSERT_TRUE(r.has_value());
+  ASSERT_TRUE(r->has_value());
+  EXPECT_EQ(**r, 10u);
+}
+
+TEST(exec_test, read_waits_for_readiness) {
+  auto rx = reactor::create().value();
+  auto [a, b] = unix_stream::pair().value();
+  auto src = async_source<unix_stream>::attach(rx, std::move(a)).value();
+
+  std::thread t{[&b] {
+    std::this_thread::sleep_for(10ms);
+    [[maybe_unused]] auto w = b.write(as_bytes("ping"));
+  }};
+
+  std::array<std::byte, 64> buf{};
+  auto r = sync_wait(rx, tio::exec::async_read(src, buf));
+  t.join();
+
+  ASSERT_TRUE(r.has_value());
+  ASSERT_TRUE(r->has_value());
+  EXPECT_EQ(**r, 4u);
+}
+
+TEST(exec_test, stopped_read_releases_its_slot) {
+  auto rx = reactor::create().value();
+  auto [a, b] = unix_stream::pair().value();
+  auto src = async_source<unix_stream>::attach(rx, std::move(a)).value();
+
+  std::stop_source ss;
+  std::thread t{[&] {
+    std::this_thread::sleep_for(10ms);
+    ss.request_stop();
+  }};
+
+  std::array<std::byte, 64> buf{};
+  auto stopped = sync_wait(rx, tio::exec::async_read(src, buf), ss.get_token());
+  t.join();
+  EXPECT_FALSE(stopped.has_value());
+  EXPECT_EQ(src.readiness()->reader, nullptr);
+
+  ASSERT_TRUE(b.write(as_bytes("ok")).has_value());
+  auto r = sync_wait(rx, tio::exec::async_read(src, buf));
+  ASSERT_TRUE(r.has_value());
+  EXPECT_EQ(r->value(), 2u);
+}
+
+TEST(exec_test, error_passes_through_then) {
+  auto rx = reactor::create().value();
+  auto [a, b] = unix_stream::pair().value();
+  auto src = async_source<unix_stream>::attach(rx, std::move(a)).value();
+  ASSERT_TRUE(src.get().shutdown(SHUT_WR).has_value());
+
+  bool ran = false;
+  auto r = sync_wait(rx, tio::exec::async_write(src, as_bytes("x")) | then([&ran](std::size_t) {
+    ran = true;
+  }));
+  ASSERT_TRUE(r.has_value());
+  EXPECT_FALSE(r->has_value());
+  EXPECT_FALSE(ran);
+}
+
+TEST(exec_test, accept_then_read) {
+  auto rx = reactor::create().value();
+  auto l = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+  const auto addr = l.local_addr().value();
+  auto listener = async_source<tcp_listener>::attach(rx, std::move(l)).value();
+
+  auto client = tcp_stream::connect(addr).value();
+  auto accepted = sync_wait(rx, tio::exec::async_accept(listener));
+  ASSERT_TRUE(accepted.has_value());
+  ASSERT_TRUE(accepted->has_value());
+
+  auto conn = async_source<tcp_stream>::attach(rx, std::move((*accepted)->first)).value();
+  ASSERT_TRUE(client.write(as_bytes("hi")).has_value());
+
+  std::array<std::byte, 64> buf{};
+  auto r = sync_wait(rx, tio::exec::async_read(conn, buf));
+  ASSERT_TRUE(r.has_value());
+  EXPECT_EQ(r->value(), 2u);
+}
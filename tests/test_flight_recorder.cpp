@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tio/flight_recorder.hpp>
+#include <tio/poll.hpp>
+#include <tio/waker.hpp>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+
+using tio::events;
+using tio::flight_event;
+using tio::flight_recorder;
+using tio::flight_scope;
+using tio::interest;
+using tio::loop_clock;
+using tio::poll;
+using tio::poll_options;
+using tio::token;
+using tio::waker;
+
+namespace {
+
+auto count_kind(const std::vector<tio::flight_record>& recs, flight_event kind) -> std::size_t {
+  std::size_t n = 0;
+  for (const auto& r : recs) {
+    n += r.kind == kind ? 1 : 0;
+  }
+  return n;
+}
+
+}
+
+TEST(flight_recorder_test, capacity_rounds_up) {
+  EXPECT_EQ(flight_recorder{100}.capacity(), 128u);
+  EXPECT_EQ(flight_recorder{0}.capacity(), 2u);
+}
+
+TEST(flight_recorder_test, keeps_last_records_oldest_first) {
+  flight_recorder rec{8};
+  for (std::uint64_t i = 0; i < 20; ++i) {
+    rec.record(flight_event::dispatch, rec.now(), 1us, i, 0);
+  }
+  const auto recs = rec.snapshot();
+  ASSERT_EQ(recs.size(), 8u);
+  for (std::size_t i = 0; i < recs.size(); ++i) {
+    EXPECT_EQ(recs[i].id, 12 + i);
+    EXPECT_EQ(recs[i].duration, 1us);
+    EXPECT_EQ(recs[i].thread, static_cast<std::uint32_t>(::gettid()));
+  }
+  EXPECT_EQ(rec.recorded(), 20u);
+}
+
+TEST(flight_recorder_test, scope_records_dispatch) {
+  flight_recorder rec{16};
+  {
+    const flight_scope scope{&rec, token{7}};
+    std::this_thread::sleep_for(1ms);
+  }
+  { const flight_scope noop{nullptr, token{8}}; }
+
+  const auto recs = rec.snapshot();
+  ASSERT_EQ(recs.size(), 1u);
+  EXPECT_EQ(recs[0].kind, flight_event::dispatch);
+  EXPECT_EQ(recs[0].id, 7u);
+  EXPECT_GE(recs[0].duration, 1ms);
+}
+
+TEST(flight_recorder_test, concurrent_writers_stay_consistent) {
+  flight_recorder rec{1024};
+  std::vector<std::thread> ts;
+  for (std::uint64_t t = 0; t < 4; ++t) {
+    ts.emplace_back([&rec, t] {
+      for (std::uint64_t i = 0; i < 50000; ++i) {
+        rec.record(flight_event::wake, loop_clock::time_point{}, 0ns, t, t * 1000);
+      }
+    });
+  }
+  for (std::size_t i = 0; i < 100; ++i) {
+    for (const auto& r : rec.snapshot()) {
+      EXPECT_EQ(r.arg, r.id * 1000);
+    }
+  }
+  for (auto& t : ts) {
+    t.join();
+  }
+  EXPECT_EQ(rec.snapshot().size(), 1024u);
+}
+
+TEST(flight_recorder_test, poll_off_by_default) {
+  auto p = poll::create().value();
+  EXPECT_EQ(p.recorder(), nullptr);
+}
+
+TEST(flight_recorder_test, poll_records_waits_registrations_and_wakes) {
+  auto p = poll::create(poll_options{.flight_records = 256}).value();
+  auto reg = p.get_registry();
+  ASSERT_NE(reg.recorder(), nullptr);
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  ASSERT_TRUE(reg.register_fd(fds[0], token{3}, interest::readable()).has_value());
+  ASSERT_TRUE(reg.reregister_fd(fds[0], token{3}, interest::readable() | interest::writable()).has_value());
+  EXPECT_FALSE(reg.reregister_fd(fds[1], token{4}, interest::readable()).has_value());
+  ASSERT_TRUE(reg.deregister_fd(fds[0]).has_value());
+  ::close(fds[0]);
+  ::close(fds[1]);
+
+  auto w = waker::create(reg, token{9}).value();
+  ASSERT_TRUE(w.wake().has_value());
+
+  events evs{8};
+  ASSERT_TRUE(p.do_poll(evs, 100ms).has_value());
+
+  const auto recs = p.recorder()->snapshot();
+  EXPECT_EQ(count_kind(recs, flight_event::register_fd), 2u);  // pipe + waker
+  EXPECT_EQ(count_kind(recs, flight_event::reregister_fd), 2u);
+  EXPECT_EQ(count_kind(recs, flight_event::deregister_fd), 1u);
+  EXPECT_EQ(count_kind(recs, flight_event::wake), 1u);
+  ASSERT_EQ(count_kind(recs, flight_event::poll_wait), 1u);
+
+  bool saw_failed_mod = false;
+  for (const auto& r : recs) {
+    if (r.kind == flight_event::reregister_fd && r.id == 4) {
+      saw_failed_mod = r.err == ENOENT;
+    }
+    if (r.kind == flight_event::poll_wait) {
+      EXPECT_EQ(r.arg, 1u);
+    }
+    if (r.kind == flight_event::wake) {
+      EXPECT_EQ(r.id, 9u);
+    }
+  }
+  EXPECT_TRUE(saw_failed_mod);
+}
+
+TEST(flight_recorder_test, writes_chrome_trace) {
+  flight_recorder rec{16};
+  rec.record(flight_event::poll_wait, rec.now(), 5us, 0, 3);
+  rec.record(flight_event::register_fd, rec.now(), 0ns, 2, 11, interest::readable().raw());
+
+  std::ostringstream out;
+  rec.write_chrome_trace(out);
+  const auto json = out.str();
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find("\"name\":\"poll_wait\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\",\"dur\":5.000,\"args\":{\"events\":3}}"), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"register\""), std::string::npos);
+  EXPECT_NE(json.find("\"fd\":11,\"token\":2,\"interest\":1,\"errno\":0"), std::string::npos);
+  EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <array>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include <tio/flush.hpp>
+#include <tio/unix/unix_stream.hpp>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using tio::flush_queue;
+using tio::outbox;
+using tio::unix_::unix_stream;
+
+namespace {
+
+auto as_bytes(const char* s) -> std::span<const std::byte> {
+  return std::as_bytes(std::span{s, std::strlen(s)});
+}
+
+auto read_all(const unix_stream& s) -> std::string {
+  std::string out;
+  std::array<std::byte, 4096> buf{};
+  while (true) {
+    auto r = s.read(buf);
+    if (!r.has_value() || *r == 0) {
+      break;
+    }
+    out.append(reinterpret_cast<const char*>(buf.data()), *r);
+  }
+  return out;
+}
+
+}
+
+TEST(flush_test, pipelined_responses_leave_in_one_syscall) {
+  auto [a, b] = unix_stream::pair().value();
+  outbox out{a.raw_fd()};
+  flush_queue fq;
+
+  const std::string body = "shared-body;";
+  out.append(as_bytes("r1;"));
+  fq.mark(out);
+  out.append_ref(std::as_bytes(std::span{body}));
+  fq.mark(out);
+  out.append(as_bytes("r3;"));
+  fq.mark(out);
+  EXPECT_EQ(fq.size(), 1u);
+
+  EXPECT_EQ(fq.flush(), 1u);
+  EXPECT_TRUE(out.empty());
+  EXPECT_TRUE(fq.empty());
+  EXPECT_EQ(fq.stats().syscalls, 1u);
+  EXPECT_EQ(fq.stats().bytes, 18u);
+  EXPECT_DOUBLE_EQ(fq.stats().bytes_per_syscall(), 18.0);
+  EXPECT_EQ(read_all(b), "r1;shared-body;r3;");
+}
+
+TEST(flush_test, outboxes_flush_in_marking_order) {
+  auto [a1, b1] = unix_stream::pair().value();
+  auto [a2, b2] = unix_stream::pair().value();
+  outbox o1{a1.raw_fd()};
+  outbox o2{a2.raw_fd()};
+  flush_queue fq;
+
+  o2.append(as_bytes("two"));
+  fq.mark(o2);
+  o1.append(as_bytes("one"));
+  fq.mark(o1);
+
+  EXPECT_EQ(fq.flush(), 2u);
+  EXPECT_EQ(read_all(b1), "one");
+  EXPECT_EQ(read_all(b2), "two");
+}
+
+TEST(flush_test, fair_share_requeues_large_outbox) {
+  auto [a1, b1] = unix_stream::pair().value();
+  auto [a2, b2] = unix_stream::pair().value();
+  outbox big{a1.raw_fd()};
+  outbox small{a2.raw_fd()};
+  flush_queue fq{4};
+
+  big.append(as_bytes("abcdefghij"));
+  fq.mark(big);
+  small.append(as_bytes("xy"));
+  fq.mark(small);
+
+  EXPECT_EQ(fq.flush(), 2u);
+  EXPECT_EQ(big.pending_bytes(), 6u);
+  EXPECT_TRUE(big.is_queued());
+  EXPECT_EQ(read_all(b2), "xy");
+
+  fq.flush();
+  fq.flush();
+  EXPECT_TRUE(big.empty());
+  EXPECT_EQ(read_all(b1), "abcdefghij");
+}
+
+TEST(flush_test, full_socket_keeps_remainder) {
+  auto [a, b] = unix_stream::pair().value();
+  constexpr int sndbuf = 4096;
+  ASSERT_EQ(::setsockopt(a.raw_fd(), SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)), 0);
+
+  outbox out{a.raw_fd()};
+  flush_queue fq;
+  const std::vector<std::byte> chunk(1 << 20, std::byte{'z'});
+  out.append_ref(chunk);
+
+  while (!out.empty()) {
+    fq.mark(out);
+    fq.flush();
+    if (fq.stats().would_block > 0) {
+      break;
+    }
+  }
+  EXPECT_GT(fq.stats().would_block, 0u);
+  EXPECT_FALSE(out.empty());
+  EXPECT_FALSE(out.is_queued());
+  EXPECT_FALSE(out.last_error().has_value());
+  EXPECT_EQ(out.pending_bytes() + fq.stats().bytes, chunk.size());
+}
+
+TEST(flush_test, arena_stays_bounded_under_partial_writes) {
+  auto [a, b] = unix_stream::pair().value();
+  outbox out{a.raw_fd()};
+
+  std::vector<std::byte> sent;
+  auto append = [&](std::size_t n) {
+    std::vector<std::byte> chunk(n);
+    for (auto& x : chunk) {
+      x = static_cast<std::byte>(sent.size() % 251);
+      sent.push_back(x);
+    }
+    out.append(chunk);
+  };
+
+  // Keep a backlog so every write is partial and the outbox never drains.
+  append(16 * 1024);
+  std::string received;
+  for (int i = 0; i < 2000; ++i) {
+    append(1000);
+    ASSERT_EQ(out.write_some(1000).value(), 1000u);
+    received += read_all(b);
+  }
+
+  EXPECT_EQ(out.pending_bytes(), 16u * 1024);
+  EXPECT_LT(out.arena_bytes(), 256u * 1024);  // 2 MB went through it
+
+  ASSERT_TRUE(out.write_some().has_value());
+  received += read_all(b);
+  ASSERT_EQ(received.size(), sent.size());
+  EXPECT_EQ(std::memcmp(received.data(), sent.data(), sent.size()), 0);
+}
+
+TEST(flush_test, pipe_falls_back_to_writev) {
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  {
+    outbox out{fds[1]};
+    flush_queue fq;
+    out.append(as_bytes("a"));
+    out.append(as_bytes("b"));
+    fq.mark(out);
+    EXPECT_EQ(fq.flush(), 1u);
+    EXPECT_FALSE(out.last_error().has_value());
+  }
+
+  std::array<char, 8> buf{};
+  EXPECT_EQ(::read(fds[0], buf.data(), buf.size()), 2);
+  EXPECT_EQ(std::string(buf.data(), 2), "ab");
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+TEST(flush_test, destroyed_outbox_leaves_queue) {
+  flush_queue fq;
+  {
+    outbox out{-1};
+    fq.mark(out);
+    EXPECT_EQ(fq.size(), 1u);
+  }
+  EXPECT_TRUE(fq.empty());
+  EXPECT_EQ(fq.flush(), 0u);
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <tio/histogram.hpp>
+#include <tio/poll.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+using tio::events;
+using tio::histogram_layout;
+using tio::histogram_snapshot;
+using tio::latency_histogram;
+using tio::poll;
+using tio::poll_options;
+
+TEST(histogram_test, layout_round_trips) {
+  for (std::uint64_t v : {0ULL, 1ULL, 63ULL, 64ULL, 65ULL, 127ULL, 128ULL, 1000ULL, 123456789ULL}) {
+    const auto i = histogram_layout::index(v);
+    EXPECT_LE(histogram_layout::lower(i), v);
+    EXPECT_GE(histogram_layout::upper(i), v);
+  }
+  EXPECT_EQ(histogram_layout::index(histogram_layout::k_max_value), histogram_layout::k_buckets - 1);
+  EXPECT_EQ(histogram_layout::index(~0ULL), histogram_layout::k_buckets - 1);
+}
+
+TEST(histogram_test, empty_snapshot_is_zero) {
+  const latency_histogram h;
+  const auto s = h.snapshot();
+  EXPECT_EQ(s.count(), 0u);
+  EXPECT_EQ(s.percentile(99), 0ns);
+  EXPECT_EQ(s.mean(), 0ns);
+}
+
+TEST(histogram_test, percentiles_within_relative_error) {
+  latency_histogram h;
+  for (std::uint64_t v = 1; v <= 100000; ++v) {
+    h.record(v * 10);
+  }
+  const auto s = h.snapshot();
+  EXPECT_EQ(s.count(), 100000u);
+  EXPECT_EQ(s.max(), 1000000ns);
+  for (const double q : {50.0, 90.0, 99.0, 99.9}) {
+    const auto want = static_cast<double>(q * 10000);
+    const auto got = static_cast<double>(s.percentile(q).count());
+    EXPECT_NEAR(got, want, want / 64 + 10) << q;
+  }
+  EXPECT_EQ(s.percentile(100), 1000000ns);
+}
+
+TEST(histogram_test, negative_durations_record_as_zero) {
+  latency_histogram h;
+  h.record(-5ns);
+  EXPECT_EQ(h.snapshot().max(), 0ns);
+  EXPECT_EQ(h.count(), 1u);
+}
+
+TEST(histogram_test, snapshots_merge) {
+  latency_histogram a;
+  latency_histogram b;
+  for (int i = 0; i < 100; ++i) {
+    a.record(100ns);
+    b.record(10us);
+  }
+  auto s = a.snapshot();
+  s.merge(b.snapshot());
+  EXPECT_EQ(s.count(), 200u);
+  EXPECT_EQ(s.percentile(25), 100ns);
+  EXPECT_NEAR(static_cast<double>(s.percentile(75).count()), 10000.0, 10000.0 / 64);
+  EXPECT_EQ(s.max(), 10us);
+
+  std::uint64_t buckets = 0;
+  s.for_each_bucket([&](auto, auto, std::uint64_t n) { buckets += n; });
+  EXPECT_EQ(buckets, 200u);
+}
+
+TEST(histogram_test, concurrent_records_are_not_lost) {
+  latency_histogram h;
+  std::vector<std::thread> ts;
+  for (int t = 0; t < 4; ++t) {
+    ts.emplace_back([&h, t] {
+      for (int i = 0; i < 100000; ++i) {
+        h.record(static_cast<std::uint64_t>(t * 1000 + i % 1000));
+      }
+    });
+  }
+  for (auto& t : ts) {
+    t.join();
+  }
+  EXPECT_EQ(h.count(), 400000u);
+  EXPECT_EQ(h.snapshot().max(), 3999ns);
+}
+
+TEST(histogram_test, reset_clears) {
+  latency_histogram h;
+  h.record(1ms);
+  h.reset();
+  EXPECT_EQ(h.snapshot().count(), 0u);
+}
+
+TEST(histogram_test, poll_latency_off_by_default) {
+  auto p = poll::create().value();
+  EXPECT_EQ(p.latency(), nullptr);
+  p.record_handler(0);
+}
+
+TEST(histogram_test, poll_records_wait_and_dispatch) {
+  auto p = poll::create(poll_options{.record_latency = true}).value();
+  ASSERT_NE(p.latency(), nullptr);
+  events evs{8};
+
+  ASSERT_TRUE(p.do_poll(evs, 5ms).has_value());
+  std::this_thread::sleep_for(2ms);
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+
+  const auto wait = p.latency()->wait.snapshot();
+  const auto dispatch = p.latency()->dispatch.snapshot();
+  EXPECT_EQ(wait.count(), 2u);
+  EXPECT_GE(wait.max(), 4ms);
+  // The first poll has no preceding batch to time.
+  EXPECT_EQ(dispatch.count(), 1u);
+  EXPECT_GE(dispatch.max(), 2ms);
+
+  auto reg = p.get_registry();
+  EXPECT_EQ(reg.latency(), p.latency());
+}
+
+TEST(histogram_test, poll_records_handler_classes) {
+  auto p = poll::create(poll_options{.record_latency = true, .handler_classes = 2}).value();
+  events evs{8};
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+
+  std::this_thread::sleep_for(1ms);
+  p.record_handler(1);
+  p.record_handler(2);
+
+  EXPECT_EQ(p.latency()->handler_classes(), 2u);
+  EXPECT_EQ(p.latency()->handler(0).count(), 0u);
+  const auto s = p.latency()->handler(1).snapshot();
+  EXPECT_EQ(s.count(), 1u);
+  EXPECT_GE(s.max(), 1ms);
+}
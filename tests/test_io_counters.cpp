@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <tio/event.hpp>
+#include <tio/io_counters.hpp>
+#include <tio/unix/unix_stream.hpp>
+
+#include <gtest/gtest.h>
+
+using tio::event;
+using tio::io_counters;
+using tio::sys::raw_event;
+using tio::unix_::unix_stream;
+
+namespace {
+
+auto make_raw(std::uint32_t flags) -> raw_event {
+  raw_event ev{};
+  ev.events = flags;
+  return ev;
+}
+
+}
+
+TEST(io_counters_test, fits_a_connection_slot) {
+  static_assert(sizeof(io_counters) <= 48);
+  const io_counters c;
+  EXPECT_EQ(c.bytes_per_read(), 0.0);
+  EXPECT_EQ(c.spurious_ratio(), 0.0);
+}
+
+TEST(io_counters_test, counts_reads_writes_and_would_block) {
+  auto [a, b] = unix_stream::pair().value();
+  io_counters ca;
+  io_counters cb;
+
+  const std::array<std::byte, 100> out{};
+  EXPECT_EQ(a.write(out, ca).value(), out.size());
+  EXPECT_EQ(a.write(out, ca).value(), out.size());
+
+  std::array<std::byte, 256> in{};
+  EXPECT_EQ(b.read(in, cb).value(), 200u);
+  EXPECT_TRUE(b.read(in, cb).error().is_would_block());
+
+  EXPECT_EQ(ca.writes, 2u);
+  EXPECT_EQ(ca.bytes_out, 200u);
+  EXPECT_EQ(ca.partial_writes, 0u);
+  EXPECT_EQ(ca.bytes_per_write(), 100.0);
+
+  EXPECT_EQ(cb.reads, 2u);
+  EXPECT_EQ(cb.bytes_in, 200u);
+  EXPECT_EQ(cb.read_would_block, 1u);
+  EXPECT_EQ(cb.bytes_per_read(), 100.0);
+  EXPECT_EQ(cb.spurious, 0u);  // no readiness event preceded the EAGAIN
+}
+
+TEST(io_counters_test, spurious_readiness) {
+  auto [a, b] = unix_stream::pair().value();
+  io_counters c;
+  std::array<std::byte, 64> in{};
+
+  const auto readable = make_raw(EPOLLIN);
+  const auto writable = make_raw(EPOLLOUT);
+
+  c.on_event(event{readable});
+  EXPECT_TRUE(b.read(in, c).error().is_would_block());
+
+  c.on_event(event{writable});
+  EXPECT_TRUE(b.read(in, c).error().is_would_block());
+
+  const std::array<std::byte, 8> out{};
+  ASSERT_TRUE(a.write(out).has_value());
+  c.on_event(event{readable});
+  EXPECT_EQ(b.read(in, c).value(), out.size());
+  EXPECT_TRUE(b.read(in, c).error().is_would_block());  // drain to EAGAIN is not spurious
+
+  EXPECT_EQ(c.events, 3u);
+  EXPECT_EQ(c.readable_events, 2u);
+  EXPECT_EQ(c.spurious, 1u);
+  EXPECT_EQ(c.read_would_block, 3u);
+  EXPECT_DOUBLE_EQ(c.spurious_ratio(), 0.5);  // writable events do not dilute it
+}
+
+TEST(io_counters_test, writable_event_keeps_read_armed) {
+  auto [a, b] = unix_stream::pair().value();
+  io_counters c;
+  std::array<std::byte, 64> in{};
+
+  // The read is deferred past a writable-only event and still finds nothing.
+  c.on_event(event{make_raw(EPOLLIN)});
+  c.on_event(event{make_raw(EPOLLOUT)});
+  EXPECT_TRUE(b.read(in, c).error().is_would_block());
+
+  EXPECT_EQ(c.spurious, 1u);
+  EXPECT_DOUBLE_EQ(c.spurious_ratio(), 1.0);
+}
+
+TEST(io_counters_test, partial_and_blocked_writes) {
+  auto [a, b] = unix_stream::pair().value();
+  const int small = 4096;
+  ASSERT_EQ(::setsockopt(a.raw_fd(), SOL_SOCKET, SO_SNDBUF, &small, sizeof(small)), 0);
+
+  io_counters c;
+  std::vector<std::byte> big(1 << 20);
+  for (int i = 0; i < 64 && c.write_would_block == 0; ++i) {
+    (void)a.write(big, c);
+  }
+  EXPECT_GE(c.partial_writes, 1u);
+  EXPECT_EQ(c.write_would_block, 1u);
+  EXPECT_GT(c.bytes_out, 0u);
+  EXPECT_LT(c.bytes_out, big.size() * c.writes);
+}
+
+TEST(io_counters_test, vectored) {
+  auto [a, b] = unix_stream::pair().value();
+  io_counters ca;
+  io_counters cb;
+
+  std::array<std::byte, 10> x{};
+  std::array<std::byte, 20> y{};
+  std::array<iovec, 2> out{{{x.data(), x.size()}, {y.data(), y.size()}}};
+  EXPECT_EQ(a.write_vectored(out, ca).value(), 30u);
+  EXPECT_EQ(ca.partial_writes, 0u);
+
+  std::array<std::byte, 64> in{};
+  std::array<iovec, 1> into{{{in.data(), in.size()}}};
+  EXPECT_EQ(b.read_vectored(into, cb).value(), 30u);
+  EXPECT_EQ(cb.bytes_in, 30u);
+}
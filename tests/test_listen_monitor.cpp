@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <tio/event.hpp>
+#include <tio/net/listen_monitor.hpp>
+#include <tio/net/tcp_listener.hpp>
+#include <tio/net/tcp_stream.hpp>
+#include <tio/poll.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+using tio::events;
+using tio::interest;
+using tio::poll;
+using tio::token;
+using tio::detail::socket_addr;
+using tio::net::listen_monitor;
+using tio::net::listen_sample;
+using tio::net::tcp_listener;
+using tio::net::tcp_stream;
+
+namespace {
+
+// Connects `n` clients and gives the kernel time to finish the handshakes;
+// nothing accepts them, so they sit in the accept queue.
+auto queue_clients(const tcp_listener& l, int n) -> std::vector<tcp_stream> {
+  const auto addr = l.local_addr().value();
+  std::vector<tcp_stream> out;
+  for (int i = 0; i < n; ++i) {
+    out.push_back(tcp_stream::connect(addr).value());
+  }
+  std::this_thread::sleep_for(20ms);
+  return out;
+}
+
+}
+
+TEST(listen_monitor_test, reads_tcp_ext_counters) {
+  const auto drops = listen_monitor::read_drops();
+  ASSERT_TRUE(drops.has_value());
+  EXPECT_GE(drops->drops, drops->overflows);
+}
+
+TEST(listen_monitor_test, rejects_bad_watch) {
+  auto m = listen_monitor::create().value();
+  EXPECT_EQ(m.begin().error().code(), EINVAL);
+
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  EXPECT_EQ(m.watch_fd(fds[0]).error().code(), ENOTSOCK);
+  ::close(fds[0]);
+  ::close(fds[1]);
+  EXPECT_EQ(m.watch_fd(-1).error().code(), EBADF);
+}
+
+TEST(listen_monitor_test, reports_accept_queue) {
+  auto l = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+  auto other = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+  auto m = listen_monitor::create().value();
+  ASSERT_TRUE(m.watch(l).has_value());
+  ASSERT_TRUE(m.watch(l).has_value());
+
+  const auto clients = queue_clients(l, 3);
+  const auto s = m.sample().value();
+  ASSERT_EQ(s.listeners.size(), 1u);
+  EXPECT_EQ(s.listeners[0].port, l.local_addr().value().port());
+  EXPECT_EQ(s.listeners[0].queued, 3u);
+  EXPECT_GT(s.listeners[0].backlog, 0u);
+  EXPECT_GT(s.listeners[0].fill(), 0.0);
+  EXPECT_EQ(s.delta.overflows, 0u);
+  EXPECT_FALSE(m.in_flight());
+
+  ASSERT_TRUE(l.accept().has_value());
+  EXPECT_EQ(m.sample().value().listeners[0].queued, 2u);
+}
+
+TEST(listen_monitor_test, dumps_both_families) {
+  auto v4 = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+  auto v6 = tcp_listener::bind(socket_addr::ipv6_loopback(0));
+  if (!v6.has_value()) {
+    GTEST_SKIP() << "no IPv6 loopback";
+  }
+  auto m = listen_monitor::create().value();
+  ASSERT_TRUE(m.watch(v4).has_value());
+  ASSERT_TRUE(m.watch(*v6).has_value());
+
+  const auto clients = queue_clients(*v6, 2);
+  const auto s = m.sample().value();
+  ASSERT_EQ(s.listeners.size(), 2u);
+  const auto& q6 = s.listeners[0].port == v6->local_addr().value().port() ? s.listeners[0] : s.listeners[1];
+  EXPECT_EQ(q6.queued, 2u);
+}
+
+TEST(listen_monitor_test, closed_listener_is_left_out) {
+  auto m = listen_monitor::create().value();
+  {
+    auto l = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+    ASSERT_TRUE(m.watch(l).has_value());
+  }
+  EXPECT_TRUE(m.sample().value().listeners.empty());
+}
+
+TEST(listen_monitor_test, samples_through_poll) {
+  auto l = tcp_listener::bind(socket_addr::ipv4_loopback(0)).value();
+  auto m = listen_monitor::create().value();
+  ASSERT_TRUE(m.watch(l).has_value());
+  const auto clients = queue_clients(l, 1);
+
+  auto p = poll::create().value();
+  ASSERT_TRUE(p.get_registry().register_source(m, token{1}, interest::readable()).has_value());
+
+  ASSERT_TRUE(m.begin().has_value());
+  EXPECT_EQ(m.begin().error().code(), EALREADY);
+
+  events evs{4};
+  std::optional<listen_sample> got;
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (!got.has_value() && std::chrono::steady_clock::now() < deadline) {
+    ASSERT_TRUE(p.do_poll(evs, 100ms).has_value());
+    for (const auto& ev : evs) {
+      ASSERT_EQ(ev.tok(), token{1});
+      got = m.on_readable().value();
+    }
+  }
+  ASSERT_TRUE(got.has_value());
+  ASSERT_EQ(got->listeners.size(), 1u);
+  EXPECT_EQ(got->listeners[0].queued, 1u);
+}
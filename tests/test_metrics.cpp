@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <tio/metrics.hpp>
+#include <tio/poll.hpp>
+
+#include <gtest/gtest.h>
+
+using tio::metric_field;
+using tio::metric_kind;
+using tio::metrics_reader;
+using tio::metrics_region;
+using tio::poll_stats;
+
+namespace {
+
+auto unique_name(const char* what) -> std::string {
+  return std::string{"tio-test-"} + what + "-" + std::to_string(::getpid());
+}
+
+}
+
+TEST(metrics_test, rejects_bad_arguments) {
+  EXPECT_FALSE(metrics_region::create("").has_value());
+  EXPECT_FALSE(metrics_region::create("a/b").has_value());
+  EXPECT_FALSE(metrics_region::create(unique_name("zero"), 0).has_value());
+}
+
+TEST(metrics_test, reader_sees_published_values) {
+  const auto name = unique_name("rw");
+  auto region = metrics_region::create(name, 4).value();
+  auto slot = region.add("listener", {{"accepted", metric_kind::counter}, {"live", metric_kind::gauge}}).value();
+  slot.publish({42, 7});
+
+  auto reader = metrics_reader::open(name).value();
+  EXPECT_EQ(reader.pid(), ::getpid());
+  ASSERT_EQ(reader.size(), 1u);
+  const auto s = reader.read(0).value();
+  EXPECT_EQ(s.label, "listener");
+  ASSERT_EQ(s.names.size(), 2u);
+  EXPECT_EQ(s.names[0], "accepted");
+  EXPECT_EQ(s.kinds[1], metric_kind::gauge);
+  EXPECT_EQ(s.values[0], 42u);
+  EXPECT_EQ(s.values[1], 7u);
+  EXPECT_GT(s.published.count(), 0);
+  EXPECT_FALSE(reader.read(1).has_value());
+}
+
+TEST(metrics_test, publishes_poll_stats) {
+  const auto name = unique_name("poll");
+  auto region = metrics_region::create(name).value();
+  auto slot = region.add_poll("reactor-0").value();
+
+  poll_stats st;
+  st.polls = 10;
+  st.events = 25;
+  st.wakes = 3;
+  st.blocked = std::chrono::nanoseconds{900};
+  slot.publish(st);
+
+  auto reader = metrics_reader::open(name).value();
+  const auto s = reader.read(0).value();
+  ASSERT_EQ(s.values.size(), metrics_region::k_poll_fields.size());
+  EXPECT_EQ(s.names[1], "events");
+  EXPECT_EQ(s.values[0], 10u);
+  EXPECT_EQ(s.values[1], 25u);
+  EXPECT_EQ(s.values[3], 900u);
+  EXPECT_EQ(s.values[9], 3u);
+}
+
+TEST(metrics_test, slot_limits) {
+  auto region = metrics_region::create(unique_name("limits"), 1).value();
+  std::vector<metric_field> many(17, metric_field{"x"});
+  EXPECT_EQ(region.add("wide", many).error().code(), EINVAL);
+  ASSERT_TRUE(region.add("one", {{"a"}}).has_value());
+  EXPECT_EQ(region.add("two", {{"a"}}).error().code(), ENOSPC);
+}
+
+TEST(metrics_test, duplicate_name_is_rejected) {
+  const auto name = unique_name("dup");
+  auto region = metrics_region::create(name).value();
+  auto slot = region.add("a", {{"x"}}).value();
+
+  const auto second = metrics_region::create(name);
+  ASSERT_FALSE(second.has_value());
+  EXPECT_EQ(second.error().code(), EEXIST);
+
+  // The first region is untouched and still publishable.
+  slot.publish({5});
+  auto reader = metrics_reader::open(name).value();
+  EXPECT_EQ(reader.read(0).value().values[0], 5u);
+}
+
+TEST(metrics_test, stale_region_is_replaced) {
+  const auto name = unique_name("stale");
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    auto region = metrics_region::create(name);
+    ::_exit(region.has_value() ? 0 : 1);  // skips the destructor, like a crash
+  }
+  int status = 0;
+  ASSERT_EQ(::waitpid(child, &status, 0), child);
+  ASSERT_EQ(WEXITSTATUS(status), 0);
+
+  auto region = metrics_region::create(name);
+  ASSERT_TRUE(region.has_value());
+  EXPECT_EQ(metrics_reader::open(name).value().pid(), ::getpid());
+}
+
+TEST(metrics_test, region_is_unlinked_with_owner) {
+  const auto name = unique_name("unlink");
+  {
+    auto region = metrics_region::create(name).value();
+    EXPECT_TRUE(metrics_reader::open(name).has_value());
+  }
+  EXPECT_FALSE(metrics_reader::open(name).has_value());
+}
+
+TEST(metrics_test, reads_are_consistent_while_publishing) {
+  const auto name = unique_name("seqlock");
+  auto region = metrics_region::create(name).value();
+  auto slot = region.add("pair", {{"a"}, {"b"}, {"c"}}).value();
+  slot.publish({0, 0, 0});
+
+  std::atomic<bool> stop{false};
+  std::thread writer{[&] {
+    for (std::uint64_t i = 1; !stop.load(std::memory_order_relaxed); ++i) {
+      slot.publish({i, i, i});
+    }
+  }};
+
+  auto reader = metrics_reader::open(name).value();
+  std::size_t ok = 0;
+  for (int i = 0; i < 100000; ++i) {
+    if (auto s = reader.read(0); s.has_value()) {
+      EXPECT_EQ(s->values[0], s->values[1]);
+      EXPECT_EQ(s->values[1], s->values[2]);
+      ++ok;
+    }
+  }
+  stop = true;
+  writer.join();
+  EXPECT_GT(ok, 0u);
+}
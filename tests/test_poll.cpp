@@ -9,7 +9,10 @@
  *
  */
 
+#include <memory>
+#include <optional>
 #include <thread>
+#include <vector>
 
 #include <tio/poll.hpp>
 
@@ -229,3 +232,78 @@ TEST(poll_test, move_construct) {
   EXPECT_EQ(evs.size(), 1u);
   EXPECT_EQ(evs[0].tok(), token{1});
 }
+
+TEST(poll_test, registry_survives_poll_move) {
+  auto p1 = poll::create().value();
+  auto reg = p1.get_registry();
+
+  auto p2 = std::move(p1);
+  pipe_fds pipe;
+  reg.register_fd(pipe.read_end, token{3}, interest::readable()).value();
+
+  char buf[] = "x";
+  ::write(pipe.write_end, buf, 1);
+
+  events evs{64};
+  p2.do_poll(evs, std::chrono::milliseconds{100}).value();
+  ASSERT_EQ(evs.size(), 1u);
+  EXPECT_EQ(evs[0].tok(), token{3});
+}
+
+TEST(poll_test, cloned_registry_registers_from_other_thread) {
+  auto p = poll::create().value();
+  auto remote = p.get_registry().try_clone().value();
+  EXPECT_TRUE(remote.is_owning());
+  EXPECT_FALSE(p.get_registry().is_owning());
+
+  pipe_fds pipe;
+  std::thread t([remote = std::move(remote), fd = pipe.read_end, wfd = pipe.write_end] {
+    remote.register_fd(fd, token{9}, interest::readable()).value();
+    char buf[] = "x";
+    ::write(wfd, buf, 1);
+  });
+
+  events evs{64};
+  p.do_poll(evs, std::chrono::milliseconds{2000}).value();
+  t.join();
+
+  ASSERT_EQ(evs.size(), 1u);
+  EXPECT_EQ(evs[0].tok(), token{9});
+}
+
+TEST(poll_test, cloned_registry_outlives_poll) {
+  pipe_fds pipe;
+  std::optional<registry> remote;
+  {
+    auto p = poll::create().value();
+    remote = p.get_registry().try_clone().value();
+  }
+  EXPECT_TRUE(remote->register_fd(pipe.read_end, token{1}, interest::readable()).has_value());
+  EXPECT_TRUE(remote->deregister_fd(pipe.read_end).has_value());
+}
+
+TEST(poll_test, concurrent_tracked_registration) {
+  auto p = poll::create(tio::poll_options{.track_registrations = true}).value();
+
+  constexpr int n_threads = 4;
+  constexpr int per_thread = 16;
+  std::vector<std::unique_ptr<pipe_fds>> pipes;
+  for (int i = 0; i < n_threads * per_thread; ++i) {
+    pipes.push_back(std::make_unique<pipe_fds>());
+  }
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n_threads; ++t) {
+    threads.emplace_back([&, t, reg = p.get_registry().try_clone().value()] {
+      for (int i = 0; i < per_thread; ++i) {
+        const auto idx = static_cast<std::size_t>(t * per_thread + i);
+        reg.register_fd(pipes[idx]->read_end, token{idx}, interest::readable()).value();
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(p.get_registry().registered_count(), static_cast<std::size_t>(n_threads * per_thread));
+}
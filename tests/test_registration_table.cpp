@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <vector>
+
+#include <tio/poll.hpp>
+#include <tio/sys/detail/registration_table.hpp>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using tio::events;
+using tio::interest;
+using tio::poll;
+using tio::poll_options;
+using tio::registration;
+using tio::token;
+using tio::detail::registration_table;
+
+namespace {
+
+struct pipe_fds {
+  int read_end;
+  int write_end;
+
+  pipe_fds() {
+    int fds[2];
+    EXPECT_EQ(::pipe(fds), 0);
+    read_end = fds[0];
+    write_end = fds[1];
+  }
+
+  ~pipe_fds() {
+    ::close(read_end);
+    ::close(write_end);
+  }
+
+  pipe_fds(const pipe_fds&) = delete;
+  auto operator=(const pipe_fds&) -> pipe_fds& = delete;
+};
+
+auto tracked_poll() -> poll {
+  return poll::create(poll_options{.track_registrations = true}).value();
+}
+
+}
+
+TEST(registration_table_test, insert_find_erase) {
+  registration_table t;
+  EXPECT_FALSE(t.contains(5));
+
+  t.insert(5, token{7}, interest::readable() | interest::writable());
+  ASSERT_TRUE(t.contains(5));
+  EXPECT_EQ(t.size(), 1u);
+  EXPECT_GE(t.capacity(), 6u);
+
+  const auto r = t.find(5).value();
+  EXPECT_EQ(r.fd, 5);
+  EXPECT_EQ(r.tok, token{7});
+  EXPECT_EQ(r.intr, interest::readable() | interest::writable());
+
+  EXPECT_TRUE(t.matches(5, token{7}, interest::readable() | interest::writable()));
+  EXPECT_FALSE(t.matches(5, token{7}, interest::readable()));
+  EXPECT_FALSE(t.matches(5, token{8}, interest::readable() | interest::writable()));
+
+  t.erase(5);
+  EXPECT_FALSE(t.contains(5));
+  EXPECT_EQ(t.size(), 0u);
+}
+
+TEST(registration_table_test, negative_and_out_of_range_fds) {
+  registration_table t;
+  EXPECT_FALSE(t.contains(-1));
+  EXPECT_FALSE(t.find(1000).has_value());
+  t.erase(1000);
+  EXPECT_EQ(t.size(), 0u);
+}
+
+TEST(registration_table_test, for_each_in_fd_order) {
+  registration_table t;
+  t.insert(9, token{1}, interest::readable());
+  t.insert(3, token{2}, interest::writable());
+
+  std::vector<int> fds;
+  t.for_each([&](const registration& r) { fds.push_back(r.fd); });
+  EXPECT_EQ(fds, (std::vector<int>{3, 9}));
+}
+
+TEST(registration_table_test, untracked_registry_reports_nothing) {
+  auto p = poll::create().value();
+  pipe_fds pipe;
+  auto reg = p.get_registry();
+
+  reg.register_fd(pipe.read_end, token{1}, interest::readable()).value();
+  EXPECT_FALSE(reg.is_tracking());
+  EXPECT_FALSE(reg.registration_of(pipe.read_end).has_value());
+  EXPECT_EQ(reg.registered_count(), 0u);
+}
+
+TEST(registration_table_test, tracks_register_and_deregister) {
+  auto p = tracked_poll();
+  pipe_fds pipe;
+  auto reg = p.get_registry();
+  ASSERT_TRUE(reg.is_tracking());
+
+  reg.register_fd(pipe.read_end, token{4}, interest::readable()).value();
+  EXPECT_EQ(reg.registered_count(), 1u);
+  EXPECT_EQ(reg.registration_of(pipe.read_end)->tok, token{4});
+
+  reg.deregister_fd(pipe.read_end).value();
+  EXPECT_EQ(reg.registered_count(), 0u);
+  EXPECT_FALSE(reg.registration_of(pipe.read_end).has_value());
+}
+
+TEST(registration_table_test, double_register_rejected) {
+  auto p = tracked_poll();
+  pipe_fds pipe;
+  auto reg = p.get_registry();
+
+  reg.register_fd(pipe.read_end, token{1}, interest::readable()).value();
+  auto r = reg.register_fd(pipe.read_end, token{2}, interest::readable());
+  ASSERT_FALSE(r.has_value());
+  EXPECT_TRUE(r.error().is_already_exists());
+  EXPECT_EQ(reg.registration_of(pipe.read_end)->tok, token{1});
+}
+
+TEST(registration_table_test, unknown_fd_rejected) {
+  auto p = tracked_poll();
+  pipe_fds pipe;
+  auto reg = p.get_registry();
+
+  auto rr = reg.reregister_fd(pipe.read_end, token{1}, interest::readable());
+  ASSERT_FALSE(rr.has_value());
+  EXPECT_EQ(rr.error().code(), ENOENT);
+
+  auto dr = reg.deregister_fd(pipe.read_end);
+  ASSERT_FALSE(dr.has_value());
+  EXPECT_EQ(dr.error().code(), ENOENT);
+}
+
+TEST(registration_table_test, redundant_reregister_elided) {
+  auto p = tracked_poll();
+  pipe_fds pipe;
+  auto reg = p.get_registry();
+
+  reg.register_fd(pipe.read_end, token{1}, interest::readable()).value();
+  reg.reregister_fd(pipe.read_end, token{1}, interest::readable()).value();
+  EXPECT_EQ(reg.elided_count(), 1u);
+
+  reg.reregister_fd(pipe.read_end, token{2}, interest::readable()).value();
+  EXPECT_EQ(reg.elided_count(), 1u);
+  EXPECT_EQ(reg.registration_of(pipe.read_end)->tok, token{2});
+
+  char buf[] = "x";
+  ::write(pipe.write_end, buf, 1);
+
+  events evs{8};
+  p.do_poll(evs, std::chrono::milliseconds{100}).value();
+  ASSERT_EQ(evs.size(), 1u);
+  EXPECT_EQ(evs[0].tok(), token{2});
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <tio/poll.hpp>
+#include <tio/stats.hpp>
+#include <tio/waker.hpp>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using tio::events;
+using tio::interest;
+using tio::poll;
+using tio::poll_options;
+using tio::poll_stats;
+using tio::token;
+using tio::waker;
+
+namespace {
+
+struct pipe_fds {
+  int read_end;
+  int write_end;
+
+  pipe_fds() {
+    int fds[2];
+    EXPECT_EQ(::pipe(fds), 0);
+    read_end = fds[0];
+    write_end = fds[1];
+  }
+
+  ~pipe_fds() {
+    ::close(read_end);
+    ::close(write_end);
+  }
+
+  pipe_fds(const pipe_fds&) = delete;
+  auto operator=(const pipe_fds&) -> pipe_fds& = delete;
+
+  void signal() const { EXPECT_EQ(::write(write_end, "x", 1), 1); }
+};
+
+auto with_stats() -> poll {
+  return poll::create(poll_options{.collect_stats = true}).value();
+}
+
+}
+
+TEST(stats_test, off_by_default) {
+  auto p = poll::create().value();
+  EXPECT_FALSE(p.stats().has_value());
+  EXPECT_FALSE(p.get_registry().stats().has_value());
+}
+
+TEST(stats_test, batch_bucket_is_power_of_two) {
+  EXPECT_EQ(poll_stats::batch_bucket(0), 0u);
+  EXPECT_EQ(poll_stats::batch_bucket(1), 1u);
+  EXPECT_EQ(poll_stats::batch_bucket(2), 2u);
+  EXPECT_EQ(poll_stats::batch_bucket(3), 2u);
+  EXPECT_EQ(poll_stats::batch_bucket(4), 3u);
+  EXPECT_EQ(poll_stats::batch_bucket(1u << 20), poll_stats::k_batch_buckets - 1);
+}
+
+TEST(stats_test, counts_polls_events_and_batches) {
+  auto p = with_stats();
+  pipe_fds a;
+  pipe_fds b;
+  p.get_registry().register_fd(a.read_end, token{1}, interest::readable()).value();
+  p.get_registry().register_fd(b.read_end, token{2}, interest::readable()).value();
+
+  events evs{16};
+  p.do_poll(evs, std::chrono::milliseconds{0}).value();
+  a.signal();
+  b.signal();
+  p.do_poll(evs, std::chrono::milliseconds{100}).value();
+  ASSERT_EQ(evs.size(), 2u);
+
+  const auto s = p.stats().value();
+  EXPECT_EQ(s.polls, 2u);
+  EXPECT_EQ(s.events, 2u);
+  EXPECT_EQ(s.saturated, 0u);
+  EXPECT_EQ(s.batch_sizes[0], 1u);
+  EXPECT_EQ(s.batch_sizes[poll_stats::batch_bucket(2)], 1u);
+}
+
+TEST(stats_test, counts_saturated_buffers) {
+  auto p = with_stats();
+  pipe_fds a;
+  pipe_fds b;
+  p.get_registry().register_fd(a.read_end, token{1}, interest::readable()).value();
+  p.get_registry().register_fd(b.read_end, token{2}, interest::readable()).value();
+  a.signal();
+  b.signal();
+
+  events evs{1};
+  p.do_poll(evs, std::chrono::milliseconds{100}).value();
+  ASSERT_EQ(evs.size(), 1u);
+  EXPECT_EQ(p.stats()->saturated, 1u);
+}
+
+TEST(stats_test, splits_blocked_and_dispatch_time) {
+  auto p = with_stats();
+  events evs{16};
+
+  p.do_poll(evs, std::chrono::milliseconds{20}).value();
+  std::this_thread::sleep_for(std::chrono::milliseconds{20});
+  p.do_poll(evs, std::chrono::milliseconds{0}).value();
+
+  const auto s = p.stats().value();
+  EXPECT_GE(s.blocked, std::chrono::milliseconds{20});
+  EXPECT_GE(s.dispatching, std::chrono::milliseconds{20});
+}
+
+TEST(stats_test, counts_ctl_calls_by_type) {
+  auto p = with_stats();
+  auto reg = p.get_registry();
+  pipe_fds a;
+
+  reg.register_fd(a.read_end, token{1}, interest::readable()).value();
+  reg.reregister_fd(a.read_end, token{1}, interest::readable() | interest::writable()).value();
+  reg.deregister_fd(a.read_end).value();
+  EXPECT_FALSE(reg.deregister_fd(a.read_end).has_value());
+
+  const auto s = p.stats().value();
+  EXPECT_EQ(s.ctl_add, 1u);
+  EXPECT_EQ(s.ctl_mod, 1u);
+  EXPECT_EQ(s.ctl_del, 2u);
+  EXPECT_EQ(s.ctl_errors, 1u);
+}
+
+TEST(stats_test, elided_reregister_is_not_a_ctl_call) {
+  auto p = poll::create(poll_options{.track_registrations = true, .collect_stats = true}).value();
+  auto reg = p.get_registry();
+  pipe_fds a;
+
+  reg.register_fd(a.read_end, token{1}, interest::readable()).value();
+  reg.reregister_fd(a.read_end, token{1}, interest::readable()).value();
+
+  EXPECT_EQ(p.stats()->ctl_mod, 0u);
+  EXPECT_EQ(reg.elided_count(), 1u);
+  reg.deregister_fd(a.read_end).value();
+}
+
+TEST(stats_test, counts_waker_wakes_and_drains) {
+  auto p = with_stats();
+  auto w = waker::create(p.get_registry(), token{7}).value();
+
+  w.wake().value();
+  w.wake().value();
+  events evs{16};
+  p.do_poll(evs, std::chrono::milliseconds{100}).value();
+  w.drain();
+
+  const auto s = p.stats().value();
+  EXPECT_EQ(s.wakes, 2u);
+  EXPECT_EQ(s.drains, 1u);
+  EXPECT_EQ(s.ctl_add, 1u);
+}
+
+TEST(stats_test, snapshot_from_another_thread) {
+  auto p = with_stats();
+  auto remote = p.get_registry().try_clone().value();
+  std::atomic<bool> done{false};
+
+  std::thread reader{[&] {
+    std::uint64_t last = 0;
+    while (!done.load(std::memory_order_acquire)) {
+      const auto s = remote.stats().value();
+      EXPECT_GE(s.polls, last);
+      last = s.polls;
+    }
+  }};
+
+  events evs{16};
+  for (int i = 0; i < 1000; ++i) {
+    p.do_poll(evs, std::chrono::milliseconds{0}).value();
+  }
+  done.store(true, std::memory_order_release);
+  reader.join();
+
+  EXPECT_EQ(remote.stats()->polls, 1000u);
+}
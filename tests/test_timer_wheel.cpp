@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <tio/sys/detail/timer_wheel.hpp>
+
+#include <gtest/gtest.h>
+
+using tio::detail::timer_wheel;
+using tio::detail::wheel_node;
+
+TEST(timer_wheel_test, fires_at_expiry) {
+  timer_wheel w{8};
+  wheel_node a;
+  wheel_node b;
+  w.schedule(&a, 3);
+  w.schedule(&b, 5);
+  EXPECT_EQ(w.size(), 2u);
+  EXPECT_EQ(w.ticks_to_next(), 3u);
+
+  std::vector<wheel_node*> fired;
+  EXPECT_EQ(w.advance(2, [&](wheel_node* n) { fired.push_back(n); }), 0u);
+  EXPECT_EQ(w.advance(4, [&](wheel_node* n) { fired.push_back(n); }), 1u);
+  ASSERT_EQ(fired.size(), 1u);
+  EXPECT_EQ(fired[0], &a);
+  EXPECT_FALSE(a.linked);
+
+  EXPECT_EQ(w.advance(5, [&](wheel_node* n) { fired.push_back(n); }), 1u);
+  EXPECT_EQ(fired.back(), &b);
+  EXPECT_EQ(w.size(), 0u);
+  EXPECT_EQ(w.ticks_to_next(), 0u);
+}
+
+TEST(timer_wheel_test, ticks_to_next_follows_cancel_and_advance) {
+  timer_wheel w{8};
+  wheel_node a;
+  wheel_node b;
+  wheel_node c;
+  w.schedule(&a, 6);
+  EXPECT_EQ(w.ticks_to_next(), 6u);
+  w.schedule(&b, 2);
+  EXPECT_EQ(w.ticks_to_next(), 2u);
+  w.schedule(&c, 11);  // next lap, bucket visited at tick 3
+  EXPECT_EQ(w.ticks_to_next(), 2u);
+
+  w.cancel(&b);
+  EXPECT_EQ(w.ticks_to_next(), 3u);
+
+  EXPECT_EQ(w.advance(4, [](wheel_node*) {}), 0u);
+  EXPECT_EQ(w.ticks_to_next(), 2u);  // a at 6
+  EXPECT_EQ(w.advance(6, [](wheel_node*) {}), 1u);
+  EXPECT_EQ(w.ticks_to_next(), 5u);  // c at 11
+  w.cancel(&c);
+  EXPECT_EQ(w.ticks_to_next(), 0u);
+}
+
+TEST(timer_wheel_test, slots_round_up_to_power_of_two) {
+  timer_wheel w{100};
+  EXPECT_EQ(w.slots(), 128u);
+}
+
+TEST(timer_wheel_test, cancel_unlinks) {
+  timer_wheel w{8};
+  wheel_node a;
+  wheel_node b;
+  wheel_node c;
+  w.schedule(&a, 2);
+  w.schedule(&b, 2);
+  w.schedule(&c, 2);
+  w.cancel(&b);
+  w.cancel(&b);
+  EXPECT_EQ(w.size(), 2u);
+
+  std::vector<wheel_node*> fired;
+  w.advance(2, [&](wheel_node* n) { fired.push_back(n); });
+  EXPECT_EQ(fired.size(), 2u);
+  EXPECT_EQ(std::count(fired.begin(), fired.end(), &b), 0);
+}
+
+TEST(timer_wheel_test, later_laps_wait_their_turn) {
+  timer_wheel w{4};
+  wheel_node a;
+  w.schedule(&a, 6);
+
+  int fired = 0;
+  w.advance(2, [&](wheel_node*) { ++fired; });
+  EXPECT_EQ(fired, 0);
+  EXPECT_TRUE(a.linked);
+  w.advance(6, [&](wheel_node*) { ++fired; });
+  EXPECT_EQ(fired, 1);
+}
+
+TEST(timer_wheel_test, long_jump_fires_everything) {
+  timer_wheel w{4};
+  std::vector<wheel_node> nodes(10);
+  for (std::uint64_t i = 0; i < nodes.size(); ++i) {
+    w.schedule(&nodes[i], i + 1);
+  }
+  EXPECT_EQ(w.advance(1000, [](wheel_node*) {}), nodes.size());
+  EXPECT_EQ(w.size(), 0u);
+}
+
+TEST(timer_wheel_test, past_expiry_clamps_to_next_tick) {
+  timer_wheel w{8};
+  w.advance(10, [](wheel_node*) {});
+  wheel_node a;
+  w.schedule(&a, 3);
+  EXPECT_EQ(a.expiry, 11u);
+  EXPECT_EQ(w.advance(11, [](wheel_node*) {}), 1u);
+}
+
+TEST(timer_wheel_test, callback_may_reschedule) {
+  timer_wheel w{8};
+  wheel_node a;
+  w.schedule(&a, 1);
+
+  int fired = 0;
+  w.advance(1, [&](wheel_node* n) {
+    ++fired;
+    w.schedule(n, 4);
+  });
+  EXPECT_TRUE(a.linked);
+  w.advance(4, [&](wheel_node*) { ++fired; });
+  EXPECT_EQ(fired, 2);
+}
@@ -10,7 +10,11 @@
  */
 
 #include <array>
+#include <cstdint>
 #include <cstring>
+#include <limits>
+
+#include <sys/socket.h>
 
 #include <tio/net/udp_socket.hpp>
 #include <tio/poll.hpp>
@@ -20,6 +24,7 @@
 using tio::events;
 using tio::interest;
 using tio::poll;
+using tio::rx_drops;
 using tio::token;
 using tio::detail::socket_addr;
 using tio::net::udp_socket;
@@ -284,3 +289,55 @@ TEST(udp_test, from_raw_fd) {
   auto sock2 = udp_socket::from_raw_fd(fd);
   EXPECT_EQ(sock2.raw_fd(), fd);
 }
+
+TEST(udp_test, rxq_overflow_get_set) {
+  auto [sock, addr] = bind_udp();
+  EXPECT_FALSE(sock.rxq_overflow().value());
+  sock.set_rxq_overflow(true).value();
+  EXPECT_TRUE(sock.rxq_overflow().value());
+}
+
+TEST(udp_test, rxq_overflow_counts_drops) {
+  auto [rx, rx_addr] = bind_udp();
+  auto [tx, tx_addr] = bind_udp();
+  rx.set_rxq_overflow(true).value();
+  const int small = 4096;
+  ASSERT_EQ(::setsockopt(rx.raw_fd(), SOL_SOCKET, SO_RCVBUF, &small, sizeof(small)), 0);
+
+  std::array<std::byte, 512> payload{};
+  std::size_t sent = 0;
+  for (int i = 0; i < 200; ++i) {
+    sent += tx.send_to(payload, rx_addr).has_value() ? 1 : 0;
+  }
+
+  rx_drops drops;
+  std::array<std::byte, 1024> buf{};
+  std::size_t received = 0;
+  while (rx.recv_from(buf, drops).has_value()) {
+    ++received;
+  }
+  ASSERT_LT(received, sent);
+  EXPECT_EQ(drops.total(), 0u);  // the queued datagrams arrived before anything was dropped
+
+  // The next datagram carries the counter.
+  tx.send_to(payload, rx_addr).value();
+  auto [n, from] = rx.recv_from(buf, drops).value();
+  EXPECT_EQ(n, payload.size());
+  EXPECT_EQ(from.port(), tx_addr.port());
+  EXPECT_EQ(drops.total(), sent - received);
+  EXPECT_EQ(drops.last(), sent - received);
+
+  tx.send_to(payload, rx_addr).value();
+  rx.recv(buf, drops).value();
+  EXPECT_EQ(drops.last(), 0u);
+  EXPECT_EQ(drops.total(), sent - received);
+}
+
+TEST(udp_test, rx_drops_survives_counter_wrap) {
+  rx_drops drops;
+  const auto max = std::numeric_limits<std::uint32_t>::max();
+  EXPECT_EQ(drops.observe(max - 1), max - 1);
+  EXPECT_EQ(drops.observe(2), 3u);
+  EXPECT_EQ(drops.total(), std::uint64_t{max} + 2);
+  EXPECT_EQ(drops.counter(), 2u);
+}
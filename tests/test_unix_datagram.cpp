@@ -22,6 +22,7 @@
 using tio::events;
 using tio::interest;
 using tio::poll;
+using tio::rx_drops;
 using tio::token;
 using tio::detail::unix_addr;
 using tio::unix_::unix_datagram;
@@ -212,6 +213,23 @@ TEST_F(unix_datagram_test, unbound_connect_send) {
   EXPECT_EQ(std::string(reinterpret_cast<const char*>(buf.data()), n), "unbound");
 }
 
+TEST_F(unix_datagram_test, rxq_overflow_recv) {
+  auto [a, b] = unix_datagram::pair().value();
+  b.set_rxq_overflow(true).value();
+  EXPECT_TRUE(b.rxq_overflow().value());
+
+  const char* msg = "counted";
+  a.send(std::as_bytes(std::span{msg, std::strlen(msg)})).value();
+
+  rx_drops drops;
+  std::array<std::byte, 128> buf{};
+  auto n = b.recv(buf, drops).value();
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(buf.data()), n), "counted");
+  EXPECT_EQ(drops.total(), 0u);
+
+  EXPECT_TRUE(b.recv(buf, drops).error().is_would_block());
+}
+
 TEST_F(unix_datagram_test, from_raw_fd) {
   auto sock = unix_datagram::bind(addr_a()).value();
   const int fd = sock.into_raw_fd();
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+#include <unistd.h>
+
+#include <tio/poll.hpp>
+#include <tio/watchdog.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+using tio::clock_mode;
+using tio::events;
+using tio::poll;
+using tio::poll_options;
+using tio::stall_report;
+using tio::token;
+using tio::watchdog;
+using tio::watchdog_options;
+
+namespace {
+
+struct collected {
+  std::mutex mu;
+  std::vector<stall_report> reports;
+
+  auto options(std::chrono::milliseconds threshold) -> watchdog_options {
+    return watchdog_options{
+      .threshold = threshold,
+      .interval = 5ms,
+      .on_stall =
+        [this](const stall_report& r) {
+          const std::lock_guard lock{mu};
+          reports.push_back(r);
+        },
+    };
+  }
+
+  auto copy() -> std::vector<stall_report> {
+    const std::lock_guard lock{mu};
+    return reports;
+  }
+};
+
+std::atomic<int> g_signalled{0};
+
+void on_signal(int) { g_signalled.fetch_add(1); }
+
+}
+
+TEST(watchdog_test, rejects_zero_threshold) {
+  EXPECT_FALSE(watchdog::create(watchdog_options{.threshold = 0ms}).has_value());
+  EXPECT_FALSE(watchdog::create(watchdog_options{.interval = 0ms}).has_value());
+}
+
+TEST(watchdog_test, reports_blocked_handler_once) {
+  collected c;
+  auto wd = watchdog::create(c.options(50ms)).value();
+  auto p = poll::create(poll_options{.flight_records = 64}).value();
+  ASSERT_TRUE(wd.watch(p.get_registry()).has_value());
+
+  events evs{4};
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+  p.mark_dispatch(token{5});
+  std::this_thread::sleep_for(200ms);
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+
+  const auto reports = c.copy();
+  ASSERT_EQ(reports.size(), 1u);
+  EXPECT_EQ(wd.stall_count(), 1u);
+  const auto& r = reports[0];
+  EXPECT_EQ(r.thread, static_cast<std::uint32_t>(::gettid()));
+  EXPECT_EQ(r.iteration, 1u);
+  EXPECT_GE(r.stalled_for, 50ms);
+  ASSERT_TRUE(r.tok.has_value());
+  EXPECT_EQ(r.tok->value(), 5u);
+  EXPECT_GE(r.tok_for, 50ms);
+  EXPECT_EQ(r.recorder, p.recorder());
+}
+
+TEST(watchdog_test, coarse_clock_poll) {
+  collected c;
+  auto wd = watchdog::create(c.options(50ms)).value();
+  auto p = poll::create(poll_options{.clock = clock_mode::coarse}).value();
+  ASSERT_TRUE(wd.watch(p.get_registry()).has_value());
+
+  events evs{4};
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+  p.mark_dispatch(token{2});
+  std::this_thread::sleep_for(150ms);
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+
+  const auto reports = c.copy();
+  ASSERT_EQ(reports.size(), 1u);
+  EXPECT_GE(reports[0].stalled_for, 50ms);
+  EXPECT_LT(reports[0].stalled_for, 150ms);
+  EXPECT_GE(reports[0].tok_for, 0ns);
+  EXPECT_LE(reports[0].tok_for, reports[0].stalled_for);
+}
+
+TEST(watchdog_test, waiting_in_select_is_not_a_stall) {
+  collected c;
+  auto wd = watchdog::create(c.options(20ms)).value();
+  auto p = poll::create().value();
+  ASSERT_TRUE(wd.watch(p.get_registry()).has_value());
+
+  events evs{4};
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(p.do_poll(evs, 20ms).has_value());
+  }
+  EXPECT_EQ(wd.stall_count(), 0u);
+}
+
+TEST(watchdog_test, report_without_marked_token) {
+  collected c;
+  auto wd = watchdog::create(c.options(20ms)).value();
+  auto p = poll::create().value();
+  ASSERT_TRUE(wd.watch(p.get_registry()).has_value());
+
+  events evs{4};
+  p.mark_dispatch(token{1});
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());  // clears the mark
+  std::this_thread::sleep_for(100ms);
+
+  const auto reports = c.copy();
+  ASSERT_EQ(reports.size(), 1u);
+  EXPECT_FALSE(reports[0].tok.has_value());
+  EXPECT_EQ(reports[0].recorder, nullptr);
+}
+
+TEST(watchdog_test, unwatched_loop_is_not_reported) {
+  collected c;
+  auto wd = watchdog::create(c.options(20ms)).value();
+  auto p = poll::create().value();
+  ASSERT_TRUE(wd.watch(p.get_registry()).has_value());
+  ASSERT_TRUE(wd.watch(p.get_registry()).has_value());
+
+  events evs{4};
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+  ASSERT_TRUE(wd.unwatch(p.get_registry()).has_value());  // the loop is done
+  std::this_thread::sleep_for(100ms);
+
+  EXPECT_EQ(wd.stall_count(), 0u);
+  EXPECT_EQ(wd.unwatch(p.get_registry()).error().code(), ENOENT);
+}
+
+TEST(watchdog_test, destroyed_poll_is_dropped) {
+  collected c;
+  auto wd = watchdog::create(c.options(20ms)).value();
+  {
+    auto p = poll::create().value();
+    ASSERT_TRUE(wd.watch(p.get_registry()).has_value());
+    events evs{4};
+    ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+  }
+  std::this_thread::sleep_for(100ms);
+  EXPECT_EQ(wd.stall_count(), 0u);
+}
+
+TEST(watchdog_test, signals_stalled_thread) {
+  struct sigaction sa{};
+  sa.sa_handler = on_signal;
+  ASSERT_EQ(::sigaction(SIGUSR1, &sa, nullptr), 0);
+
+  auto opts = watchdog_options{.threshold = 20ms, .interval = 5ms, .signal = SIGUSR1};
+  auto wd = watchdog::create(std::move(opts)).value();
+  auto p = poll::create().value();
+  ASSERT_TRUE(wd.watch(p.get_registry()).has_value());
+
+  events evs{4};
+  ASSERT_TRUE(p.do_poll(evs, 0ms).has_value());
+  for (int i = 0; i < 100 && g_signalled.load() == 0; ++i) {
+    std::this_thread::sleep_for(5ms);
+  }
+  EXPECT_EQ(g_signalled.load(), 1);
+
+  sa.sa_handler = SIG_DFL;
+  ::sigaction(SIGUSR1, &sa, nullptr);
+}
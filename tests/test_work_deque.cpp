@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <tio/sys/detail/work_deque.hpp>
+
+#include <gtest/gtest.h>
+
+using tio::detail::work_deque;
+
+TEST(work_deque_test, owner_pops_lifo_thieves_steal_fifo) {
+  std::array<int, 3> v{1, 2, 3};
+  work_deque<int*> d{4};
+  for (auto& x : v) {
+    d.push(&x);
+  }
+  EXPECT_EQ(d.size(), 3u);
+
+  EXPECT_EQ(d.steal(), &v[0]);
+  EXPECT_EQ(d.pop(), &v[2]);
+  EXPECT_EQ(d.pop(), &v[1]);
+  EXPECT_EQ(d.pop(), nullptr);
+  EXPECT_EQ(d.steal(), nullptr);
+  EXPECT_TRUE(d.empty());
+}
+
+TEST(work_deque_test, grows_past_initial_capacity) {
+  std::vector<int> v(100);
+  work_deque<int*> d{8};
+  for (auto& x : v) {
+    d.push(&x);
+  }
+  EXPECT_GE(d.capacity(), 100u);
+  EXPECT_EQ(d.size(), 100u);
+
+  for (std::size_t i = v.size(); i-- > 0;) {
+    EXPECT_EQ(d.pop(), &v[i]);
+  }
+}
+
+TEST(work_deque_test, every_item_taken_exactly_once) {
+  constexpr std::size_t n = 100000;
+  constexpr int thieves = 3;
+
+  std::vector<int> items(n);
+  std::vector<std::atomic<int>> taken(n);
+  work_deque<int*> d{16};
+  std::atomic<bool> done{false};
+
+  auto take = [&](int* p) { taken[static_cast<std::size_t>(p - items.data())].fetch_add(1); };
+
+  std::vector<std::thread> ts;
+  for (int t = 0; t < thieves; ++t) {
+    ts.emplace_back([&] {
+      while (!done.load(std::memory_order_acquire) || !d.empty()) {
+        if (int* p = d.steal()) {
+          take(p);
+        }
+      }
+    });
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    d.push(&items[i]);
+    if (i % 3 == 0) {
+      if (int* p = d.pop()) {
+        take(p);
+      }
+    }
+  }
+  while (int* p = d.pop()) {
+    take(p);
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& t : ts) {
+    t.join();
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    ASSERT_EQ(taken[i].load(), 1) << "item " << i;
+  }
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <tio/event.hpp>
+#include <tio/poll.hpp>
+#include <tio/work_pool.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+using tio::completion_queue;
+using tio::events;
+using tio::poll;
+using tio::token;
+using tio::work_item;
+using tio::work_pool;
+
+namespace {
+
+constexpr auto k_done = token{1};
+
+// Polls until `pred` holds, draining `cq` on each of its events.
+template <typename pred_t>
+void drive(poll& p, completion_queue& cq, pred_t pred) {
+  events evs{16};
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (!pred() && std::chrono::steady_clock::now() < deadline) {
+    ASSERT_TRUE(p.do_poll(evs, 100ms).has_value());
+    for (const auto& ev : evs) {
+      if (ev.tok() == k_done) {
+        cq.drain();
+      }
+    }
+  }
+}
+
+struct counting_item : work_item {
+  std::atomic<int>* ran;
+
+  explicit counting_item(std::atomic<int>* r) noexcept
+    : work_item{&counting_item::run_fn}, ran{r} {}
+
+  static void run_fn(work_item* self) noexcept {
+    static_cast<counting_item*>(self)->ran->fetch_add(1);
+  }
+};
+
+}
+
+TEST(work_pool_test, zero_threads_is_rejected) {
+  auto r = work_pool::create(0);
+  ASSERT_FALSE(r.has_value());
+  EXPECT_EQ(r.error().code(), EINVAL);
+}
+
+TEST(work_pool_test, completions_run_on_the_draining_thread) {
+  auto p = poll::create().value();
+  auto cq = completion_queue::create(p.get_registry(), k_done).value();
+  auto pool = work_pool::create(4).value();
+
+  constexpr int n = 1000;
+  const auto loop_thread = std::this_thread::get_id();
+  int completed = 0;
+  bool wrong_thread = false;
+  long long sum = 0;
+
+  for (int i = 0; i < n; ++i) {
+    pool.submit(cq, [i] { return i * 2; }, [&, loop_thread](int v) {
+      sum += v;
+      ++completed;
+      wrong_thread |= std::this_thread::get_id() != loop_thread;
+    });
+  }
+
+  drive(p, cq, [&] { return completed == n; });
+  EXPECT_EQ(completed, n);
+  EXPECT_EQ(sum, static_cast<long long>(n) * (n - 1));
+  EXPECT_FALSE(wrong_thread);
+  EXPECT_LE(cq.wake_count(), static_cast<std::uint64_t>(n));
+}
+
+TEST(work_pool_test, burst_of_completions_costs_one_wake) {
+  auto p = poll::create().value();
+  auto cq = completion_queue::create(p.get_registry(), k_done).value();
+  auto pool = work_pool::create(2).value();
+
+  constexpr int n = 64;
+  std::atomic<int> ran{0};
+  int completed = 0;
+  for (int i = 0; i < n; ++i) {
+    pool.submit(cq, [&ran] { ran.fetch_add(1); }, [&completed] { ++completed; });
+  }
+
+  while (ran.load() != n) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(50ms);
+
+  drive(p, cq, [&] { return completed == n; });
+  EXPECT_EQ(completed, n);
+  EXPECT_EQ(cq.wake_count(), 1u);
+}
+
+TEST(work_pool_test, nested_submissions_are_stolen) {
+  auto pool = work_pool::create(4).value();
+
+  constexpr int fan_out = 2000;
+  std::atomic<int> ran{0};
+  std::vector<counting_item> children(fan_out, counting_item{&ran});
+
+  struct parent_item : work_item {
+    work_pool* pool;
+    std::vector<counting_item>* children;
+  } parent{{[](work_item* self) noexcept {
+             auto* p = static_cast<parent_item*>(self);
+             for (auto& c : *p->children) {
+               p->pool->submit(&c);
+             }
+           }},
+           &pool,
+           &children};
+
+  pool.submit(&parent);
+
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (ran.load() != fan_out && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(ran.load(), fan_out);
+}
+
+TEST(work_pool_test, parked_workers_wake_for_new_work) {
+  auto pool = work_pool::create(2).value();
+  std::atomic<int> ran{0};
+  counting_item a{&ran};
+  counting_item b{&ran};
+
+  pool.submit(&a);
+  std::this_thread::sleep_for(50ms);
+  EXPECT_GE(pool.park_count(), 1u);
+
+  pool.submit(&b);
+  const auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (ran.load() != 2 && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(ran.load(), 2);
+}
+
+TEST(work_pool_test, destructor_finishes_queued_work) {
+  std::atomic<int> ran{0};
+  std::vector<counting_item> items(500, counting_item{&ran});
+  {
+    auto pool = work_pool::create(3).value();
+    for (auto& it : items) {
+      pool.submit(&it);
+    }
+  }
+  EXPECT_EQ(ran.load(), 500);
+}
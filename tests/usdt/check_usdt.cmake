@@ -0,0 +1,34 @@
+# Checks that libtio carries a stapsdt note for every documented probe.
+# Invoked by ctest as
+#   cmake -DREADELF=... -DLIBRARY=<libtio.a> -P check_usdt.cmake
+
+cmake_policy(SET CMP0007 NEW)
+
+set(probes
+    poll_enter poll_exit
+    register reregister deregister
+    accept
+    read write
+    recv send
+)
+
+execute_process(
+    COMMAND ${READELF} --notes ${LIBRARY}
+    OUTPUT_VARIABLE notes
+    RESULT_VARIABLE rc
+)
+if (NOT rc EQUAL 0)
+    message(FATAL_ERROR "readelf failed on ${LIBRARY}")
+endif ()
+
+set(failures 0)
+foreach (probe IN LISTS probes)
+    if (NOT notes MATCHES "Provider: tio[\r\n]+[ \t]*Name: ${probe}[\r\n]")
+        message(SEND_ERROR "missing probe tio:${probe}")
+        math(EXPR failures "${failures} + 1")
+    endif ()
+endforeach ()
+
+if (failures EQUAL 0)
+    message(STATUS "usdt: all probes present")
+endif ()
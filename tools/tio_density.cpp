@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+// Connection-density harness: grows one poll to N registered sources in
+// steps and, at every step, reports registration cost, memory per source
+// and `do_poll` cost while only a small subset is active. Deregistration
+// of the full set is timed at the end.
+//
+//   tio_density [--unix | --tcp] [-n 1k,10k,100k,1m] [-a active] [-i iters] [--track]
+//
+// Every source is one end of a connected pair (`unix_stream::pair()` or a
+// loopback TCP connection); the other end stays unregistered and is used
+// to make the active subset readable. Both ends live in this process, so
+// N sources need 2N descriptors; RLIMIT_NOFILE is raised to its hard limit
+// and the top step is clamped to what fits.
+//
+// User memory is the RSS delta. Kernel memory is the system-wide Slab
+// delta from /proc/meminfo, split into socket creation and epoll
+// registration; run on a quiet machine.
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <tio/tio.hpp>
+
+using namespace std::chrono_literals;
+using namespace tio;
+
+namespace {
+
+using clock_type = loop_clock::clock;
+
+struct config {
+  bool tcp = false;
+  std::vector<std::size_t> steps{1000, 10000, 100000, 1000000};
+  std::size_t active = 16;
+  std::size_t iterations = 10000;
+  bool track = false;
+};
+
+struct mem_sample {
+  std::uint64_t rss = 0;
+  std::uint64_t slab = 0;
+};
+
+auto sample_memory() -> mem_sample {
+  mem_sample m;
+  std::ifstream statm{"/proc/self/statm"};
+  std::uint64_t size = 0;
+  std::uint64_t resident = 0;
+  if (statm >> size >> resident) {
+    m.rss = resident * static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+  }
+
+  std::ifstream meminfo{"/proc/meminfo"};
+  std::string key;
+  std::uint64_t kb = 0;
+  std::string unit;
+  while (meminfo >> key >> kb) {
+    std::getline(meminfo, unit);
+    if (key == "Slab:") {
+      m.slab = kb * 1024;
+      break;
+    }
+  }
+  return m;
+}
+
+auto per(std::uint64_t before, std::uint64_t after, std::size_t n) -> double {
+  return after > before && n > 0 ? static_cast<double>(after - before) / static_cast<double>(n) : 0.0;
+}
+
+auto ns_per(clock_type::duration d, std::size_t n) -> double {
+  return n == 0 ? 0.0
+                : static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count())
+                    / static_cast<double>(n);
+}
+
+// Raises the soft descriptor limit to the hard limit and returns it.
+auto raise_nofile() -> std::size_t {
+  rlimit rl{};
+  if (::getrlimit(RLIMIT_NOFILE, &rl) != 0) {
+    return 1024;
+  }
+  rl.rlim_cur = rl.rlim_max;
+  (void)::setrlimit(RLIMIT_NOFILE, &rl);
+  (void)::getrlimit(RLIMIT_NOFILE, &rl);
+  return static_cast<std::size_t>(rl.rlim_cur);
+}
+
+class unix_factory {
+public:
+  using stream_type = unix_::unix_stream;
+
+  auto make() -> result<std::pair<stream_type, stream_type>> { return unix_::unix_stream::pair(); }
+};
+
+// Loopback connections, spread over several listeners so the ephemeral
+// port range is not exhausted for a single destination.
+class tcp_factory {
+public:
+  using stream_type = net::tcp_stream;
+
+  static constexpr std::size_t k_per_listener = 16384;
+
+  auto make() -> result<std::pair<stream_type, stream_type>> {
+    if (!addr_.has_value() || on_current_ == k_per_listener) {
+      auto l = net::tcp_listener::bind(detail::socket_addr::ipv4_loopback(0));
+      if (!l.has_value()) {
+        return std::unexpected{l.error()};
+      }
+      auto a = l->local_addr();
+      if (!a.has_value()) {
+        return std::unexpected{a.error()};
+      }
+      listeners_.push_back(std::move(*l));
+      addr_ = *a;
+      on_current_ = 0;
+    }
+
+    auto c = net::tcp_stream::connect(*addr_);
+    if (!c.has_value()) {
+      return std::unexpected{c.error()};
+    }
+    for (int attempt = 0;; ++attempt) {
+      auto a = listeners_.back().accept();
+      if (a.has_value()) {
+        ++on_current_;
+        return std::pair{std::move(a->first), std::move(*c)};
+      }
+      if (!a.error().is_would_block() || attempt == 10000) {
+        return std::unexpected{a.error()};
+      }
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  std::vector<net::tcp_listener> listeners_;
+  std::optional<detail::socket_addr> addr_;
+  std::size_t on_current_ = 0;
+};
+
+template <typename factory_t>
+auto run(const config& cfg, std::size_t max_sources) -> int {
+  using stream_t = typename factory_t::stream_type;
+
+  auto p = poll::create(poll_options{.track_registrations = cfg.track});
+  if (!p.has_value()) {
+    std::println(stderr, "poll: {}", p.error());
+    return 1;
+  }
+  auto reg = p->get_registry();
+  factory_t factory;
+
+  std::vector<stream_t> local;
+  std::vector<stream_t> peer;
+  // Steps are sorted, so the last one is the most that will be opened.
+  const auto most = std::min(cfg.steps.back(), max_sources);
+  local.reserve(most);
+  peer.reserve(most);
+
+  events evs{std::max<std::size_t>(cfg.active, 1) * 2};
+  std::array<std::byte, 64> drain{};
+  const std::array<std::byte, 1> one{std::byte{1}};
+
+  std::println("{:>9} {:>10} {:>11} {:>12} {:>12} {:>11} {:>11} {:>10}", "sources", "reg ns/op", "user B/src",
+               "kern B/sock", "kern B/reg", "poll0 ns", "pollA ns", "ns/event");
+
+  for (const auto step : cfg.steps) {
+    const auto target = std::min(step, max_sources);
+    if (target <= local.size()) {
+      continue;
+    }
+    const auto first = local.size();
+    const auto added = target - first;
+
+    const auto m0 = sample_memory();
+    while (local.size() < target) {
+      auto pr = factory.make();
+      if (!pr.has_value()) {
+        std::println(stderr, "create at {}: {}", local.size(), pr.error());
+        return 1;
+      }
+      local.push_back(std::move(pr->first));
+      peer.push_back(std::move(pr->second));
+    }
+
+    const auto m1 = sample_memory();
+    const auto r0 = clock_type::now();
+    for (auto i = first; i < target; ++i) {
+      if (auto r = reg.register_source(local[i], token{i}, interest::readable()); !r.has_value()) {
+        std::println(stderr, "register at {}: {}", i, r.error());
+        return 1;
+      }
+    }
+    const auto r1 = clock_type::now();
+    const auto m2 = sample_memory();
+
+    // Nothing ready: the floor cost of epoll_wait at this population.
+    const auto e0 = clock_type::now();
+    for (std::size_t it = 0; it < cfg.iterations; ++it) {
+      (void)p->do_poll(evs, 0ms);
+    }
+    const auto e1 = clock_type::now();
+
+    // A fixed subset spread across the table becomes readable each round.
+    const auto active = std::min(cfg.active, target);
+    const auto stride = active == 0 ? 1 : target / active;
+    clock_type::duration busy{};
+    std::size_t seen = 0;
+    for (std::size_t it = 0; it < cfg.iterations; ++it) {
+      for (std::size_t k = 0; k < active; ++k) {
+        (void)peer[k * stride].write(one);
+      }
+      const auto t0 = clock_type::now();
+      (void)p->do_poll(evs, 0ms);
+      busy += clock_type::now() - t0;
+      seen += evs.size();
+      for (const auto& ev : evs) {
+        (void)local[ev.tok().value()].read(drain);
+      }
+    }
+
+    std::println("{:>9} {:>10.0f} {:>11.0f} {:>12.0f} {:>12.0f} {:>11.0f} {:>11.0f} {:>10.1f}", target,
+                 ns_per(r1 - r0, added), per(m0.rss, m2.rss, added), per(m0.slab, m1.slab, added),
+                 per(m1.slab, m2.slab, added), ns_per(e1 - e0, cfg.iterations),
+                 ns_per(busy, cfg.iterations), ns_per(busy, seen));
+  }
+
+  const auto d0 = clock_type::now();
+  for (auto& s : local) {
+    (void)reg.deregister_source(s);
+  }
+  const auto d1 = clock_type::now();
+  std::println("deregister {} sources: {:.0f} ns/op", local.size(), ns_per(d1 - d0, local.size()));
+  return 0;
+}
+
+auto parse_count(std::string_view s, std::size_t& out) -> bool {
+  const auto* end = s.data() + s.size();
+  const auto [ptr, ec] = std::from_chars(s.data(), end, out);
+  if (ec != std::errc{}) {
+    return false;
+  }
+  const std::string_view suffix{ptr, end};
+  if (suffix == "k" || suffix == "K") {
+    out *= 1000;
+  } else if (suffix == "m" || suffix == "M") {
+    out *= 1000000;
+  } else if (!suffix.empty()) {
+    return false;
+  }
+  return true;
+}
+
+auto parse_args(int argc, char* argv[], config& cfg) -> bool {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view a{argv[i]};
+    if (a == "--unix") {
+      cfg.tcp = false;
+      continue;
+    }
+    if (a == "--tcp") {
+      cfg.tcp = true;
+      continue;
+    }
+    if (a == "--track") {
+      cfg.track = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      return false;
+    }
+    std::string_view v{argv[++i]};
+    if (a == "-n") {
+      cfg.steps.clear();
+      while (!v.empty()) {
+        const auto comma = v.find(',');
+        if (!parse_count(v.substr(0, comma), cfg.steps.emplace_back()) || cfg.steps.back() == 0) {
+          return false;
+        }
+        v = comma == std::string_view::npos ? std::string_view{} : v.substr(comma + 1);
+      }
+      std::ranges::sort(cfg.steps);
+    } else if (a == "-a") {
+      if (!parse_count(v, cfg.active)) {
+        return false;
+      }
+    } else if (a == "-i") {
+      if (!parse_count(v, cfg.iterations) || cfg.iterations == 0) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+  return !cfg.steps.empty();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  config cfg;
+  if (!parse_args(argc, argv, cfg)) {
+    std::println(stderr, "usage: {} [--unix | --tcp] [-n 1k,10k,100k,1m] [-a active] [-i iters] [--track]",
+                 argv[0]);
+    return 2;
+  }
+
+  // Two descriptors per source plus headroom for the poll, listeners and stdio.
+  const auto nofile = raise_nofile();
+  const auto headroom = cfg.tcp ? 64 + cfg.steps.back() / tcp_factory::k_per_listener : 64;
+  const auto max_sources = nofile > headroom ? (nofile - headroom) / 2 : 0;
+  if (max_sources < cfg.steps.back()) {
+    std::println(stderr, "RLIMIT_NOFILE {} allows {} sources; larger steps are clamped", nofile, max_sources);
+  }
+
+  std::println("{} sources, {} active, {} iterations per step{}", cfg.tcp ? "tcp" : "unix_stream", cfg.active,
+               cfg.iterations, cfg.track ? ", registration table on" : "");
+  return cfg.tcp ? run<tcp_factory>(cfg, max_sources) : run<unix_factory>(cfg, max_sources);
+}
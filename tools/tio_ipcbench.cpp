@@ -0,0 +1,503 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+// Transport matrix for local IPC: ping-pong latency and one-way streaming
+// bandwidth over loopback tcp_stream, unix_stream, unix_datagram and a
+// pipe pair, for message sizes from 16 B to 1 MiB.
+//
+//   tio_ipcbench [-t tcp,unix,dgram,pipe] [-s 16,1k,1m] [-m pingpong|stream|both]
+//                [-d millis] [-w millis]
+//
+// The client and the peer run on separate threads, each driving its own
+// poll. Ping-pong latency is half the round trip of one message echoed
+// back. Streaming bandwidth counts the bytes the peer actually read while
+// the measurement window was open. tio has no splice or shared-memory
+// transport, so every row goes through the socket or pipe buffers.
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <print>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <tio/tio.hpp>
+
+using namespace std::chrono_literals;
+using namespace tio;
+
+namespace {
+
+using clock_type = loop_clock::clock;
+
+constexpr std::size_t k_chunk = 64 * 1024;
+
+enum class mode { ping_pong, stream };
+
+struct config {
+  std::vector<std::string> transports{"tcp", "unix", "dgram", "pipe"};
+  std::vector<std::size_t> sizes{16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576};
+  bool ping_pong = true;
+  bool stream = true;
+  std::chrono::milliseconds duration{1000};
+  std::chrono::milliseconds warmup{100};
+};
+
+// One side of a bidirectional link. `read` and `write` keep the transport's
+// own framing: a datagram read returns one whole message.
+template <typename stream_t>
+struct stream_end {
+  stream_t s;
+
+  auto read(std::span<std::byte> buf) -> result<std::size_t> { return s.read(buf); }
+  auto write(std::span<const std::byte> buf) -> result<std::size_t> { return s.write(buf); }
+  auto attach(const registry& reg) -> void_result {
+    return reg.register_source(s, token{0}, interest::readable() | interest::writable());
+  }
+};
+
+struct dgram_end {
+  unix_::unix_datagram s;
+
+  auto read(std::span<std::byte> buf) -> result<std::size_t> { return s.recv(buf); }
+  auto write(std::span<const std::byte> buf) -> result<std::size_t> { return s.send(buf); }
+  auto attach(const registry& reg) -> void_result {
+    return reg.register_source(s, token{0}, interest::readable() | interest::writable());
+  }
+};
+
+struct pipe_end {
+  unix_::pipe_sender tx;
+  unix_::pipe_receiver rx;
+
+  auto read(std::span<std::byte> buf) -> result<std::size_t> { return rx.read(buf); }
+  auto write(std::span<const std::byte> buf) -> result<std::size_t> { return tx.write(buf); }
+  auto attach(const registry& reg) -> void_result {
+    if (auto r = reg.register_source(rx, token{0}, interest::readable()); !r.has_value()) {
+      return r;
+    }
+    return reg.register_source(tx, token{1}, interest::writable());
+  }
+};
+
+template <typename end_t>
+using duplex = std::pair<end_t, end_t>;
+
+auto make_tcp() -> result<duplex<stream_end<net::tcp_stream>>> {
+  using end_t = stream_end<net::tcp_stream>;
+  auto l = net::tcp_listener::bind(detail::socket_addr::ipv4_loopback(0));
+  if (!l.has_value()) {
+    return std::unexpected{l.error()};
+  }
+  auto addr = l->local_addr();
+  if (!addr.has_value()) {
+    return std::unexpected{addr.error()};
+  }
+  auto c = net::tcp_stream::connect(*addr);
+  if (!c.has_value()) {
+    return std::unexpected{c.error()};
+  }
+
+  // Loopback handshakes finish in the kernel; the accept queue fills
+  // almost immediately.
+  for (int attempt = 0;; ++attempt) {
+    auto a = l->accept();
+    if (a.has_value()) {
+      (void)c->set_nodelay(true);
+      (void)a->first.set_nodelay(true);
+      return duplex<end_t>{end_t{std::move(*c)}, end_t{std::move(a->first)}};
+    }
+    if (!a.error().is_would_block() || attempt == 1000) {
+      return std::unexpected{a.error()};
+    }
+    std::this_thread::sleep_for(1ms);
+  }
+}
+
+auto make_unix() -> result<duplex<stream_end<unix_::unix_stream>>> {
+  using end_t = stream_end<unix_::unix_stream>;
+  auto p = unix_::unix_stream::pair();
+  if (!p.has_value()) {
+    return std::unexpected{p.error()};
+  }
+  return duplex<end_t>{end_t{std::move(p->first)}, end_t{std::move(p->second)}};
+}
+
+auto make_dgram() -> result<duplex<dgram_end>> {
+  auto p = unix_::unix_datagram::pair();
+  if (!p.has_value()) {
+    return std::unexpected{p.error()};
+  }
+  return duplex<dgram_end>{dgram_end{std::move(p->first)}, dgram_end{std::move(p->second)}};
+}
+
+auto make_pipes() -> result<duplex<pipe_end>> {
+  auto there = unix_::make_pipe();
+  if (!there.has_value()) {
+    return std::unexpected{there.error()};
+  }
+  auto back = unix_::make_pipe();
+  if (!back.has_value()) {
+    return std::unexpected{back.error()};
+  }
+  return duplex<pipe_end>{
+    pipe_end{std::move(there->first), std::move(back->second)},
+    pipe_end{std::move(back->first), std::move(there->second)},
+  };
+}
+
+struct shared_state {
+  std::atomic<bool> measuring{false};
+  std::atomic<bool> stop{false};
+  std::atomic<std::uint64_t> bytes{0};
+};
+
+struct cell {
+  histogram_snapshot latency;
+  std::uint64_t messages = 0;
+  double bytes_per_sec = 0;
+  std::chrono::duration<double> window{};
+};
+
+// Peer side: echoes everything back in ping-pong mode, discards it in
+// streaming mode, and counts bytes read inside the measurement window.
+template <typename end_t>
+void serve(end_t& e, std::size_t size, bool echo, shared_state& st) {
+  auto p = poll::create();
+  if (!p.has_value() || !e.attach(p->get_registry()).has_value()) {
+    return;
+  }
+
+  std::vector<std::byte> buf(std::max(size, k_chunk));
+  std::size_t out_off = 0;
+  std::size_t out_len = 0;
+  std::uint64_t bytes = 0;
+  events evs{8};
+
+  while (!st.stop.load(std::memory_order_relaxed)) {
+    result<std::size_t> n = 0;
+    if (out_len > 0) {
+      n = e.write(std::span{buf}.subspan(out_off, out_len - out_off));
+      if (n.has_value()) {
+        out_off += *n;
+        if (out_off == out_len) {
+          out_off = out_len = 0;
+        }
+      }
+    } else {
+      n = e.read(buf);
+      if (n.has_value()) {
+        if (*n == 0) {
+          break;
+        }
+        if (st.measuring.load(std::memory_order_relaxed)) {
+          bytes += *n;
+        }
+        out_len = echo ? *n : 0;
+      }
+    }
+    if (!n.has_value()) {
+      if (!n.error().is_would_block()) {
+        break;
+      }
+      (void)p->do_poll(evs, 10ms);
+    }
+  }
+  st.bytes.store(bytes, std::memory_order_relaxed);
+}
+
+template <typename end_t>
+auto ping_pong(end_t& e, std::size_t size, const config& cfg) -> result<cell> {
+  auto p = poll::create();
+  if (!p.has_value()) {
+    return std::unexpected{p.error()};
+  }
+  if (auto r = e.attach(p->get_registry()); !r.has_value()) {
+    return std::unexpected{r.error()};
+  }
+
+  const std::vector<std::byte> tx(size, std::byte{'x'});
+  std::vector<std::byte> rx(std::max(size, k_chunk));
+  events evs{8};
+  cell out;
+  latency_histogram latency;
+
+  const auto measure_from = clock_type::now() + cfg.warmup;
+  const auto end = measure_from + cfg.duration;
+
+  for (auto now = clock_type::now(); now < end;) {
+    const auto t0 = now;
+    std::size_t sent = 0;
+    std::size_t got = 0;
+    while (got < size) {
+      bool write_idle = sent == size;
+      if (!write_idle) {
+        auto n = e.write(std::span{tx}.subspan(sent));
+        if (!n.has_value()) {
+          if (!n.error().is_would_block()) {
+            return std::unexpected{n.error()};
+          }
+          write_idle = true;
+        } else {
+          sent += *n;
+        }
+      }
+
+      auto n = e.read(rx);
+      if (!n.has_value()) {
+        if (!n.error().is_would_block()) {
+          return std::unexpected{n.error()};
+        }
+        if (write_idle) {
+          (void)p->do_poll(evs, 100ms);
+        }
+      } else if (*n == 0) {
+        return std::unexpected{error{ECONNRESET}};
+      } else {
+        got += *n;
+      }
+    }
+
+    now = clock_type::now();
+    if (t0 >= measure_from) {
+      latency.record((now - t0) / 2);
+      ++out.messages;
+    }
+  }
+
+  out.latency = latency.snapshot();
+  out.window = cfg.duration;
+  out.bytes_per_sec = static_cast<double>(out.messages * size) / out.window.count();
+  return out;
+}
+
+template <typename end_t>
+auto stream(end_t& e, std::size_t size, const config& cfg, shared_state& st) -> result<cell> {
+  auto p = poll::create();
+  if (!p.has_value()) {
+    return std::unexpected{p.error()};
+  }
+  if (auto r = e.attach(p->get_registry()); !r.has_value()) {
+    return std::unexpected{r.error()};
+  }
+
+  const std::vector<std::byte> tx(size, std::byte{'x'});
+  events evs{8};
+  cell out;
+
+  const auto measure_from = clock_type::now() + cfg.warmup;
+  const auto end = measure_from + cfg.duration;
+  std::size_t off = 0;
+  auto now = clock_type::now();
+  auto t0 = now;
+  while (now < end) {
+    auto n = e.write(std::span{tx}.subspan(off));
+    if (!n.has_value()) {
+      if (!n.error().is_would_block()) {
+        return std::unexpected{n.error()};
+      }
+      (void)p->do_poll(evs, 10ms);
+    } else {
+      off = (off + *n) % size;
+    }
+
+    now = clock_type::now();
+    if (now >= measure_from && !st.measuring.load(std::memory_order_relaxed)) {
+      st.measuring.store(true, std::memory_order_relaxed);
+      t0 = now;
+    }
+  }
+  out.window = now - t0;
+  return out;
+}
+
+template <typename end_t>
+auto run_cell(duplex<end_t> ends, mode m, std::size_t size, const config& cfg) -> result<cell> {
+  shared_state st;
+  std::thread peer{[&] { serve(ends.second, size, m == mode::ping_pong, st); }};
+
+  auto r = m == mode::ping_pong ? ping_pong(ends.first, size, cfg) : stream(ends.first, size, cfg, st);
+  st.stop.store(true, std::memory_order_relaxed);
+  peer.join();
+
+  if (r.has_value() && m == mode::stream) {
+    const auto bytes = st.bytes.load(std::memory_order_relaxed);
+    r->bytes_per_sec = static_cast<double>(bytes) / r->window.count();
+    r->messages = bytes / size;
+  }
+  return r;
+}
+
+auto format_size(std::size_t n) -> std::string {
+  if (n >= 1024 * 1024 && n % (1024 * 1024) == 0) {
+    return std::format("{}M", n / (1024 * 1024));
+  }
+  if (n >= 1024 && n % 1024 == 0) {
+    return std::format("{}K", n / 1024);
+  }
+  return std::format("{}", n);
+}
+
+void print_row(std::string_view name, std::size_t size, mode m, const result<cell>& r) {
+  if (!r.has_value()) {
+    std::println("{:<6} {:>6}  n/a ({})", name, format_size(size), r.error());
+    return;
+  }
+  const auto secs = r->window.count();
+  const auto mib = r->bytes_per_sec / (1024.0 * 1024.0);
+  if (m == mode::stream) {
+    std::println("{:<6} {:>6} {:>12.0f} {:>10.1f}", name, format_size(size),
+                 static_cast<double>(r->messages) / secs, mib);
+    return;
+  }
+  const auto us = [](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()) / 1000.0; };
+  const auto& h = r->latency;
+  std::println("{:<6} {:>6} {:>12.0f} {:>10.1f} {:>8.2f} {:>8.2f} {:>8.2f} {:>8.2f} {:>8.2f}", name,
+               format_size(size), static_cast<double>(r->messages) / secs, mib, us(h.percentile(50)),
+               us(h.percentile(90)), us(h.percentile(99)), us(h.percentile(99.9)), us(h.max()));
+}
+
+template <typename end_t, typename make_t>
+void run_transport(std::string_view name, make_t make, mode m, const config& cfg) {
+  for (const auto size : cfg.sizes) {
+    auto ends = make();
+    if (!ends.has_value()) {
+      print_row(name, size, m, std::unexpected{ends.error()});
+      continue;
+    }
+    print_row(name, size, m, run_cell<end_t>(std::move(*ends), m, size, cfg));
+  }
+}
+
+void run_mode(mode m, const config& cfg) {
+  if (m == mode::ping_pong) {
+    std::println("\nping-pong (latency is one-way: round trip / 2, in us)");
+    std::println("{:<6} {:>6} {:>12} {:>10} {:>8} {:>8} {:>8} {:>8} {:>8}", "xport", "size", "msgs/s",
+                 "MiB/s", "p50", "p90", "p99", "p99.9", "max");
+  } else {
+    std::println("\nstream (one direction, bytes read by the peer)");
+    std::println("{:<6} {:>6} {:>12} {:>10}", "xport", "size", "msgs/s", "MiB/s");
+  }
+
+  for (const auto& t : cfg.transports) {
+    if (t == "tcp") {
+      run_transport<stream_end<net::tcp_stream>>(t, make_tcp, m, cfg);
+    } else if (t == "unix") {
+      run_transport<stream_end<unix_::unix_stream>>(t, make_unix, m, cfg);
+    } else if (t == "dgram") {
+      run_transport<dgram_end>(t, make_dgram, m, cfg);
+    } else if (t == "pipe") {
+      run_transport<pipe_end>(t, make_pipes, m, cfg);
+    }
+  }
+}
+
+// Comma separated list; sizes accept a k or m suffix (binary units).
+auto split(std::string_view s) -> std::vector<std::string_view> {
+  std::vector<std::string_view> out;
+  while (!s.empty()) {
+    const auto comma = s.find(',');
+    out.push_back(s.substr(0, comma));
+    s = comma == std::string_view::npos ? std::string_view{} : s.substr(comma + 1);
+  }
+  return out;
+}
+
+auto parse_size(std::string_view s, std::size_t& out) -> bool {
+  const auto* end = s.data() + s.size();
+  const auto [ptr, ec] = std::from_chars(s.data(), end, out);
+  if (ec != std::errc{} || out == 0) {
+    return false;
+  }
+  const std::string_view suffix{ptr, end};
+  if (suffix == "k" || suffix == "K") {
+    out *= 1024;
+  } else if (suffix == "m" || suffix == "M") {
+    out *= 1024 * 1024;
+  } else if (!suffix.empty()) {
+    return false;
+  }
+  return true;
+}
+
+auto parse_args(int argc, char* argv[], config& cfg) -> bool {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view a{argv[i]};
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const std::string_view v{argv[++i]};
+    long ms = 0;
+    if (a == "-t") {
+      cfg.transports.clear();
+      for (const auto t : split(v)) {
+        if (t != "tcp" && t != "unix" && t != "dgram" && t != "pipe") {
+          return false;
+        }
+        cfg.transports.emplace_back(t);
+      }
+    } else if (a == "-s") {
+      cfg.sizes.clear();
+      for (const auto t : split(v)) {
+        if (!parse_size(t, cfg.sizes.emplace_back())) {
+          return false;
+        }
+      }
+    } else if (a == "-m") {
+      cfg.ping_pong = v == "pingpong" || v == "both";
+      cfg.stream = v == "stream" || v == "both";
+    } else if (a == "-d") {
+      if (std::from_chars(v.data(), v.data() + v.size(), ms).ec != std::errc{}) {
+        return false;
+      }
+      cfg.duration = std::chrono::milliseconds{ms};
+    } else if (a == "-w") {
+      if (std::from_chars(v.data(), v.data() + v.size(), ms).ec != std::errc{}) {
+        return false;
+      }
+      cfg.warmup = std::chrono::milliseconds{ms};
+    } else {
+      return false;
+    }
+  }
+  return !cfg.transports.empty() && !cfg.sizes.empty() && (cfg.ping_pong || cfg.stream)
+         && cfg.duration.count() > 0 && cfg.warmup.count() >= 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  config cfg;
+  if (!parse_args(argc, argv, cfg)) {
+    std::println(
+      stderr,
+      "usage: {} [-t tcp,unix,dgram,pipe] [-s 16,1k,1m] [-m pingpong|stream|both] [-d millis] [-w millis]",
+      argv[0]
+    );
+    return 2;
+  }
+
+  std::println("{} ms per cell (+{} ms warmup)", cfg.duration.count(), cfg.warmup.count());
+  if (cfg.ping_pong) {
+    run_mode(mode::ping_pong, cfg);
+  }
+  if (cfg.stream) {
+    run_mode(mode::stream, cfg);
+  }
+  return 0;
+}
@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+// Request/response load generator for tio servers. Every request is
+// `size` bytes and complete once the same number of bytes came back, so
+// it works against examples/echo_server.cpp as-is.
+//
+//   tio_loadgen [--tcp host:port | --unix path] [-c conns] [-t threads]
+//               [-s size] [-d seconds] [-w warmup] [-r total_rate]
+//
+// Without -r each connection runs closed-loop (next request when the
+// previous response completes). With -r requests follow a fixed arrival
+// schedule and latency is taken from the scheduled send time, so a stalled
+// server is charged for the requests it delayed (no coordinated omission).
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <optional>
+#include <format>
+#include <print>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <arpa/inet.h>
+
+#include <tio/tio.hpp>
+
+using namespace std::chrono_literals;
+using namespace tio;
+using namespace tio::net;
+
+namespace {
+
+using clock_type = loop_clock::clock;
+using time_point = loop_clock::time_point;
+
+struct config {
+  std::optional<detail::socket_addr> tcp = detail::socket_addr::ipv4_loopback(9000);
+  std::string unix_path;
+  std::size_t connections = 100;
+  std::size_t threads = 1;
+  std::size_t size = 64;
+  double rate = 0;
+  std::chrono::seconds duration{10};
+  std::chrono::seconds warmup{1};
+};
+
+struct worker_result {
+  histogram_snapshot latency;
+  std::uint64_t completed = 0;
+  std::uint64_t connect_errors = 0;
+  std::uint64_t io_errors = 0;
+  std::uint64_t backlog = 0;
+};
+
+template <typename stream_t>
+struct connection {
+  stream_t stream;
+  bool connected = false;
+  bool alive = true;
+  std::size_t queued = 0;     // requests not yet fully written
+  std::size_t write_off = 0;  // progress through the request being written
+  std::size_t read_off = 0;   // progress through the response being read
+  std::deque<time_point> inflight;  // intended send time per request
+};
+
+template <typename stream_t>
+auto connect(const config& cfg) -> result<stream_t> {
+  if constexpr (std::is_same_v<stream_t, tcp_stream>) {
+    auto s = tcp_stream::connect(*cfg.tcp);
+    if (s.has_value()) {
+      (void)s->set_nodelay(true);
+    }
+    return s;
+  } else {
+    return unix_::unix_stream::connect(detail::unix_addr::from_pathname(cfg.unix_path));
+  }
+}
+
+template <typename stream_t>
+class worker {
+public:
+  worker(const config& cfg, std::size_t conns, double rate)
+    : cfg_{cfg}, conns_want_{conns}, payload_(cfg.size, std::byte{'x'}), rate_{rate} {}
+
+  auto run(time_point start) -> worker_result {
+    auto p = poll::create();
+    if (!p.has_value()) {
+      std::println(stderr, "poll: {}", p.error());
+      res_.io_errors = 1;
+      return res_;
+    }
+    poll_.emplace(std::move(p.value()));
+
+    conns_.reserve(conns_want_);
+    for (std::size_t i = 0; i < conns_want_; ++i) {
+      auto s = connect<stream_t>(cfg_);
+      if (!s.has_value()) {
+        ++res_.connect_errors;
+        continue;
+      }
+      auto& c = conns_.emplace_back(connection<stream_t>{.stream = std::move(s.value())});
+      if (!poll_->get_registry()
+             .register_source(c.stream, token{conns_.size() - 1}, interest::readable() | interest::writable())
+             .has_value()) {
+        c.alive = false;
+        ++res_.connect_errors;
+      }
+    }
+
+    measure_from_ = start + cfg_.warmup;
+    const auto end = measure_from_ + cfg_.duration;
+    const auto interval = rate_ > 0 ? std::chrono::duration_cast<clock_type::duration>(
+                                        std::chrono::duration<double>{1.0 / rate_}
+                                      )
+                                    : clock_type::duration::zero();
+    next_send_ = start;
+
+    events evs{1024};
+    auto now = clock_type::now();
+    while (now < end) {
+      std::optional<std::chrono::milliseconds> timeout = 10ms;
+      if (rate_ > 0) {
+        const auto until = std::chrono::ceil<std::chrono::milliseconds>(next_send_ - now);
+        timeout = std::clamp(until, 0ms, 10ms);
+      }
+      if (!poll_->do_poll(evs, timeout).has_value()) {
+        ++res_.io_errors;
+        break;
+      }
+      now = poll_->loop_now();
+
+      for (const auto& ev : evs) {
+        on_event(conns_[ev.tok().value()], ev, now);
+      }
+
+      if (rate_ > 0) {
+        while (next_send_ <= now) {
+          if (!schedule(next_send_)) {
+            break;
+          }
+          next_send_ += interval;
+        }
+      }
+    }
+
+    for (const auto& c : conns_) {
+      res_.backlog += c.inflight.size();
+    }
+    res_.latency = latency_.snapshot();
+    return res_;
+  }
+
+private:
+  void on_event(connection<stream_t>& c, const event& ev, time_point now) {
+    if (!c.alive) {
+      return;
+    }
+    if (!c.connected && ev.is_writable()) {
+      const auto e = c.stream.take_error();
+      if (!e.has_value() || e->code() != 0) {
+        fail(c, true);
+        return;
+      }
+      c.connected = true;
+      if (rate_ == 0) {
+        enqueue(c, now);
+      }
+    }
+    if (ev.is_readable()) {
+      on_readable(c, now);
+    }
+    if (c.alive && ev.is_writable()) {
+      flush(c);
+    }
+    if (c.alive && (ev.is_error() || ev.is_read_closed())) {
+      fail(c, !c.connected);
+    }
+  }
+
+  void on_readable(connection<stream_t>& c, time_point now) {
+    while (c.alive) {
+      auto n = c.stream.read(buf_);
+      if (!n.has_value()) {
+        if (!n.error().is_would_block()) {
+          fail(c, false);
+        }
+        return;
+      }
+      if (*n == 0) {
+        fail(c, false);
+        return;
+      }
+
+      c.read_off += *n;
+      while (c.read_off >= cfg_.size && !c.inflight.empty()) {
+        c.read_off -= cfg_.size;
+        const auto sent = c.inflight.front();
+        c.inflight.pop_front();
+        if (sent >= measure_from_) {
+          latency_.record(now - sent);
+          ++res_.completed;
+        }
+        if (rate_ == 0) {
+          enqueue(c, now);
+        }
+      }
+    }
+  }
+
+  // Open loop: hands the request due at `at` to the next connected
+  // connection, round robin. False when no connection is usable.
+  auto schedule(time_point at) -> bool {
+    for (std::size_t i = 0; i < conns_.size(); ++i) {
+      auto& c = conns_[next_conn_++ % conns_.size()];
+      if (c.alive && c.connected) {
+        enqueue(c, at);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void enqueue(connection<stream_t>& c, time_point at) {
+    c.inflight.push_back(at);
+    ++c.queued;
+    flush(c);
+  }
+
+  void flush(connection<stream_t>& c) {
+    while (c.queued > 0) {
+      const std::span<const std::byte> rest{payload_.data() + c.write_off, cfg_.size - c.write_off};
+      auto n = c.stream.write(rest);
+      if (!n.has_value()) {
+        if (!n.error().is_would_block()) {
+          fail(c, false);
+        }
+        return;
+      }
+      c.write_off += *n;
+      if (c.write_off == cfg_.size) {
+        c.write_off = 0;
+        --c.queued;
+      }
+    }
+  }
+
+  void fail(connection<stream_t>& c, bool during_connect) {
+    c.alive = false;
+    ++(during_connect ? res_.connect_errors : res_.io_errors);
+    (void)poll_->get_registry().deregister_source(c.stream);
+  }
+
+  const config& cfg_;
+  std::size_t conns_want_;
+  std::vector<std::byte> payload_;
+  double rate_;
+  std::optional<poll> poll_;
+  std::vector<connection<stream_t>> conns_;
+  std::array<std::byte, 64 * 1024> buf_{};
+  time_point measure_from_{};
+  time_point next_send_{};
+  std::size_t next_conn_ = 0;
+  latency_histogram latency_;
+  worker_result res_;
+};
+
+auto parse_host_port(std::string_view s) -> std::optional<detail::socket_addr> {
+  const auto colon = s.rfind(':');
+  if (colon == std::string_view::npos) {
+    return std::nullopt;
+  }
+  std::uint16_t port = 0;
+  const auto ps = s.substr(colon + 1);
+  if (std::from_chars(ps.data(), ps.data() + ps.size(), port).ec != std::errc{}) {
+    return std::nullopt;
+  }
+
+  const std::string host{s.substr(0, colon)};
+  sockaddr_in v4{};
+  if (::inet_pton(AF_INET, host.c_str(), &v4.sin_addr) == 1) {
+    v4.sin_family = AF_INET;
+    v4.sin_port = htons(port);
+    return detail::socket_addr::from_raw(reinterpret_cast<const sockaddr*>(&v4), sizeof(v4));
+  }
+  sockaddr_in6 v6{};
+  const auto h6 = host.size() > 2 && host.front() == '[' ? host.substr(1, host.size() - 2) : host;
+  if (::inet_pton(AF_INET6, h6.c_str(), &v6.sin6_addr) == 1) {
+    v6.sin6_family = AF_INET6;
+    v6.sin6_port = htons(port);
+    return detail::socket_addr::from_raw(reinterpret_cast<const sockaddr*>(&v6), sizeof(v6));
+  }
+  return std::nullopt;
+}
+
+template <typename t_t>
+auto parse_num(std::string_view s, t_t& out) -> bool {
+  return std::from_chars(s.data(), s.data() + s.size(), out).ec == std::errc{};
+}
+
+auto parse_args(int argc, char* argv[], config& cfg) -> bool {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view a{argv[i]};
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const std::string_view v{argv[++i]};
+    long secs = 0;
+    if (a == "--tcp") {
+      cfg.tcp = parse_host_port(v);
+      if (!cfg.tcp.has_value()) {
+        return false;
+      }
+    } else if (a == "--unix") {
+      cfg.tcp.reset();
+      cfg.unix_path = v;
+    } else if (a == "-c") {
+      if (!parse_num(v, cfg.connections)) {
+        return false;
+      }
+    } else if (a == "-t") {
+      if (!parse_num(v, cfg.threads)) {
+        return false;
+      }
+    } else if (a == "-s") {
+      if (!parse_num(v, cfg.size)) {
+        return false;
+      }
+    } else if (a == "-r") {
+      if (!parse_num(v, cfg.rate)) {
+        return false;
+      }
+    } else if (a == "-d") {
+      if (!parse_num(v, secs)) {
+        return false;
+      }
+      cfg.duration = std::chrono::seconds{secs};
+    } else if (a == "-w") {
+      if (!parse_num(v, secs)) {
+        return false;
+      }
+      cfg.warmup = std::chrono::seconds{secs};
+    } else {
+      return false;
+    }
+  }
+  return cfg.connections > 0 && cfg.threads > 0 && cfg.size > 0 && cfg.rate >= 0
+         && cfg.duration.count() > 0;
+}
+
+template <typename stream_t>
+auto run_all(const config& cfg) -> worker_result {
+  const auto threads = std::min(cfg.threads, cfg.connections);
+  std::vector<worker_result> results(threads);
+  std::vector<std::thread> ts;
+  const auto start = clock_type::now() + 100ms;
+
+  for (std::size_t t = 0; t < threads; ++t) {
+    const auto conns = cfg.connections / threads + (t < cfg.connections % threads ? 1 : 0);
+    ts.emplace_back([&, t, conns] {
+      worker<stream_t> w{cfg, conns, cfg.rate / static_cast<double>(threads)};
+      results[t] = w.run(start);
+    });
+  }
+  for (auto& t : ts) {
+    t.join();
+  }
+
+  worker_result total;
+  for (const auto& r : results) {
+    total.latency.merge(r.latency);
+    total.completed += r.completed;
+    total.connect_errors += r.connect_errors;
+    total.io_errors += r.io_errors;
+    total.backlog += r.backlog;
+  }
+  return total;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  config cfg;
+  if (!parse_args(argc, argv, cfg)) {
+    std::println(
+      stderr,
+      "usage: {} [--tcp host:port | --unix path] [-c conns] [-t threads] [-s size] "
+      "[-d seconds] [-w warmup] [-r total_rate]",
+      argv[0]
+    );
+    return 2;
+  }
+
+  const auto target = cfg.tcp.has_value() ? std::format("tcp {}", *cfg.tcp)
+                                          : std::format("unix {}", cfg.unix_path);
+  const auto mode = cfg.rate > 0 ? std::format("open loop {} req/s", cfg.rate) : std::string{"closed loop"};
+  std::println(
+    "{}: {} connections, {} threads, {} B requests, {}, {}s (+{}s warmup)",
+    target, cfg.connections, cfg.threads, cfg.size, mode, cfg.duration.count(), cfg.warmup.count()
+  );
+
+  const auto r = cfg.tcp.has_value() ? run_all<tcp_stream>(cfg) : run_all<unix_::unix_stream>(cfg);
+  const auto secs = static_cast<double>(cfg.duration.count());
+  const auto rps = static_cast<double>(r.completed) / secs;
+  const auto us = [](std::chrono::nanoseconds ns) { return static_cast<double>(ns.count()) / 1000.0; };
+
+  std::println("requests   {} ({:.0f} req/s, {:.2f} MiB/s each way)", r.completed, rps,
+               rps * static_cast<double>(cfg.size) / (1024.0 * 1024.0));
+  std::println("latency us mean {:.1f}  p50 {:.1f}  p90 {:.1f}  p99 {:.1f}  p99.9 {:.1f}  p99.99 {:.1f}  max {:.1f}",
+               us(r.latency.mean()), us(r.latency.percentile(50)), us(r.latency.percentile(90)),
+               us(r.latency.percentile(99)), us(r.latency.percentile(99.9)),
+               us(r.latency.percentile(99.99)), us(r.latency.max()));
+  std::println("errors     connect {}  io {}  unanswered at end {}", r.connect_errors, r.io_errors, r.backlog);
+  return r.completed > 0 ? 0 : 1;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+// Live view of a process's `metrics_region`.
+//
+//   tio_top [-i millis] [-n refreshes] <region>
+//   tio_top                                       (lists regions in /dev/shm)
+//
+// Every slot is one row: counters are shown as per-second rates over the
+// refresh interval, gauges as their current value. Poll slots (from
+// `metrics_region::add_poll`) also get a busy column, the share of time
+// spent dispatching rather than blocked in epoll_wait. The region is only
+// mapped and read, so the inspected process makes no syscalls for it.
+
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <tio/metrics.hpp>
+
+using namespace std::chrono_literals;
+using namespace tio;
+
+namespace {
+
+struct config {
+  std::string region;
+  std::chrono::milliseconds interval{1000};
+  std::size_t refreshes = 0;  // 0 = until interrupted
+};
+
+auto human(double v) -> std::string {
+  if (v >= 1e9) {
+    return std::format("{:.1f}G", v / 1e9);
+  }
+  if (v >= 1e6) {
+    return std::format("{:.1f}M", v / 1e6);
+  }
+  if (v >= 1e4) {
+    return std::format("{:.1f}k", v / 1e3);
+  }
+  return std::format("{:.0f}", v);
+}
+
+auto index_of(const metrics_sample& s, std::string_view name) -> std::optional<std::size_t> {
+  for (std::size_t i = 0; i < s.names.size(); ++i) {
+    if (s.names[i] == name) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+auto row(const metrics_sample& now, const metrics_sample* prev, double secs) -> std::string {
+  std::string out = std::format("{:<20}", now.label);
+  const bool comparable = prev != nullptr && prev->values.size() == now.values.size();
+
+  for (std::size_t i = 0; i < now.values.size(); ++i) {
+    if (now.kinds[i] == metric_kind::gauge) {
+      out += std::format("  {} {}", now.names[i], human(static_cast<double>(now.values[i])));
+      continue;
+    }
+    if (now.names[i].ends_with("_ns")) {
+      continue;  // folded into busy%
+    }
+    const auto delta = comparable && now.values[i] >= prev->values[i] ? now.values[i] - prev->values[i] : 0;
+    out += std::format("  {}/s {}", now.names[i], human(secs > 0 ? static_cast<double>(delta) / secs : 0.0));
+  }
+
+  const auto blocked = index_of(now, "blocked_ns");
+  const auto dispatch = index_of(now, "dispatch_ns");
+  if (comparable && blocked.has_value() && dispatch.has_value()) {
+    const auto b = static_cast<double>(now.values[*blocked]) - static_cast<double>(prev->values[*blocked]);
+    const auto d = static_cast<double>(now.values[*dispatch]) - static_cast<double>(prev->values[*dispatch]);
+    out += std::format("  busy {:.1f}%", b + d > 0 ? 100.0 * d / (b + d) : 0.0);
+  }
+  return out;
+}
+
+auto list_regions() -> int {
+  std::size_t found = 0;
+  std::error_code ec;
+  for (const auto& entry : std::filesystem::directory_iterator{"/dev/shm", ec}) {
+    const auto name = entry.path().filename().string();
+    if (auto r = metrics_reader::open(name); r.has_value()) {
+      std::println("{:<32} pid {:<8} {} slots", name, r->pid(), r->size());
+      ++found;
+    }
+  }
+  if (found == 0) {
+    std::println(stderr, "no tio metrics regions in /dev/shm");
+    return 1;
+  }
+  return 0;
+}
+
+auto run(const config& cfg) -> int {
+  auto reader = metrics_reader::open(cfg.region);
+  if (!reader.has_value()) {
+    std::println(stderr, "open {}: {}", cfg.region, reader.error());
+    return 1;
+  }
+
+  std::vector<std::optional<metrics_sample>> prev;
+  auto last = std::chrono::steady_clock::now();
+  for (std::size_t n = 0; cfg.refreshes == 0 || n <= cfg.refreshes; ++n) {
+    if (n != 0) {
+      std::this_thread::sleep_for(cfg.interval);
+    }
+    const auto t = std::chrono::steady_clock::now();
+    const auto secs = std::chrono::duration<double>(t - last).count();
+    last = t;
+
+    std::vector<std::optional<metrics_sample>> cur(reader->size());
+    for (std::size_t i = 0; i < cur.size(); ++i) {
+      cur[i] = reader->read(i);
+    }
+
+    // The first pass only primes the rates.
+    if (n != 0) {
+      std::print("\x1b[H\x1b[2J");
+      std::println("{} (pid {}), {} slots, every {} ms", cfg.region, reader->pid(), cur.size(),
+                   cfg.interval.count());
+      for (std::size_t i = 0; i < cur.size(); ++i) {
+        if (!cur[i].has_value()) {
+          continue;
+        }
+        const auto* p = i < prev.size() && prev[i].has_value() ? &*prev[i] : nullptr;
+        std::println("{}", row(*cur[i], p, secs));
+      }
+    }
+    prev = std::move(cur);
+  }
+  return 0;
+}
+
+auto parse_args(int argc, char* argv[], config& cfg) -> bool {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view a{argv[i]};
+    if (a == "-i" || a == "-n") {
+      if (i + 1 >= argc) {
+        return false;
+      }
+      const std::string_view v{argv[++i]};
+      std::size_t x = 0;
+      if (std::from_chars(v.data(), v.data() + v.size(), x).ec != std::errc{}) {
+        return false;
+      }
+      if (a == "-i") {
+        if (x == 0) {
+          return false;
+        }
+        cfg.interval = std::chrono::milliseconds{static_cast<std::chrono::milliseconds::rep>(x)};
+      } else {
+        cfg.refreshes = x;
+      }
+    } else if (cfg.region.empty() && !a.starts_with('-')) {
+      cfg.region = a;
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  config cfg;
+  if (!parse_args(argc, argv, cfg)) {
+    std::println(stderr, "usage: {} [-i millis] [-n refreshes] [region]", argv[0]);
+    return 2;
+  }
+  return cfg.region.empty() ? list_regions() : run(cfg);
+}
@@ -0,0 +1,534 @@
+/*
+ * Copyright (c) 2025 tio project
+ *
+ * This is the source code of the tio project.
+ * It is licensed under the MIT License; you should have received a copy
+ * of the license in this archive (see LICENSE).
+ *
+ * Author: Abolfazl Abbasi
+ *
+ */
+
+// Loopback UDP packets-per-second and drop benchmark for udp_socket.
+//
+//   tio_udpbench [-s 64,512,1400] [--tx single|mmsg|gso] [--rx single|mmsg|gro]
+//                [-r rx_sockets] [-t tx_threads] [-f flows] [-b batch]
+//                [--rcvbuf bytes] [-d millis]
+//
+// Senders blast open loop; every sender thread round-robins over `flows`
+// connected sockets so SO_REUSEPORT hashing spreads the load. Receivers
+// are one thread and poll per socket; with -r > 1 the sockets share the
+// port through SO_REUSEPORT. Without --tx/--rx the default matrix pairs
+// single/single, mmsg/mmsg and gso/gro, each on one socket and on -r.
+//
+// udp_socket has no batch or offload calls, so mmsg (sendmmsg/recvmmsg)
+// and gso/gro (UDP_SEGMENT/UDP_GRO) run on its raw_fd(). Drops are
+// packets sent minus packets received; the kernel's view is the
+// RcvbufErrors delta from /proc/net/snmp (system-wide).
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <tio/tio.hpp>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+using namespace std::chrono_literals;
+using namespace tio;
+
+namespace {
+
+using clock_type = loop_clock::clock;
+
+enum class tx_mode { single, mmsg, gso };
+enum class rx_mode { single, mmsg, gro };
+
+struct config {
+  std::vector<std::size_t> sizes{64, 512, 1400};
+  std::optional<tx_mode> tx;
+  std::optional<rx_mode> rx;
+  std::size_t rx_sockets = 4;
+  std::size_t tx_threads = 2;
+  std::size_t flows = 8;
+  std::size_t batch = 32;
+  int rcvbuf = 0;
+  std::chrono::milliseconds duration{2000};
+};
+
+struct run_spec {
+  tx_mode tx;
+  rx_mode rx;
+  std::size_t sockets;
+  std::size_t size;
+};
+
+struct run_result {
+  std::uint64_t sent = 0;
+  std::uint64_t received = 0;
+  std::uint64_t received_bytes = 0;
+  std::uint64_t rcvbuf_errors = 0;
+  std::chrono::duration<double> elapsed{};
+};
+
+auto name(tx_mode m) -> std::string_view {
+  switch (m) {
+    case tx_mode::single: return "single";
+    case tx_mode::mmsg: return "mmsg";
+    case tx_mode::gso: return "gso";
+  }
+  return "?";
+}
+
+auto name(rx_mode m) -> std::string_view {
+  switch (m) {
+    case rx_mode::single: return "single";
+    case rx_mode::mmsg: return "mmsg";
+    case rx_mode::gro: return "gro";
+  }
+  return "?";
+}
+
+// Udp: RcvbufErrors from /proc/net/snmp, or 0 when unavailable.
+auto rcvbuf_errors() -> std::uint64_t {
+  std::ifstream snmp{"/proc/net/snmp"};
+  std::string header;
+  std::string values;
+  while (std::getline(snmp, header) && std::getline(snmp, values)) {
+    if (!header.starts_with("Udp:")) {
+      continue;
+    }
+    std::istringstream hs{header};
+    std::istringstream vs{values};
+    std::string key;
+    std::string val;
+    while (hs >> key && vs >> val) {
+      if (key == "RcvbufErrors") {
+        std::uint64_t n = 0;
+        std::from_chars(val.data(), val.data() + val.size(), n);
+        return n;
+      }
+    }
+  }
+  return 0;
+}
+
+auto set_int_opt(int fd, int level, int opt, int val) -> void_result {
+  if (::setsockopt(fd, level, opt, &val, sizeof(val)) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  return {};
+}
+
+// udp_socket::bind cannot set options before bind, so reuseport sockets
+// are built on a raw descriptor and adopted.
+auto bind_receiver(const detail::socket_addr& addr, bool reuse_port, int rcvbuf) -> result<net::udp_socket> {
+  const int fd = ::socket(addr.family(), SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  auto s = net::udp_socket::from_raw_fd(fd);
+  if (reuse_port) {
+    if (auto r = set_int_opt(fd, SOL_SOCKET, SO_REUSEPORT, 1); !r.has_value()) {
+      return std::unexpected{r.error()};
+    }
+  }
+  if (rcvbuf > 0) {
+    if (auto r = set_int_opt(fd, SOL_SOCKET, SO_RCVBUF, rcvbuf); !r.has_value()) {
+      return std::unexpected{r.error()};
+    }
+  }
+  if (::bind(fd, addr.as_sockaddr(), addr.len()) < 0) {
+    return std::unexpected{error::last_os_error()};
+  }
+  return s;
+}
+
+struct shared_state {
+  std::atomic<bool> stop{false};
+  std::atomic<std::uint64_t> sent{0};
+  std::atomic<std::uint64_t> received{0};
+  std::atomic<std::uint64_t> received_bytes{0};
+};
+
+// Drains `s` until EAGAIN with the chosen receive path, then waits.
+void receive(net::udp_socket& s, rx_mode mode, std::size_t batch, shared_state& st) {
+  auto p = poll::create();
+  if (!p.has_value() || !p->get_registry().register_source(s, token{0}, interest::readable()).has_value()) {
+    return;
+  }
+
+  constexpr std::size_t k_slot = 64 * 1024;
+  std::vector<std::byte> buf(k_slot * (mode == rx_mode::mmsg ? batch : 1));
+  std::vector<iovec> iovs(batch);
+  std::vector<mmsghdr> msgs(batch);
+  for (std::size_t i = 0; i < batch; ++i) {
+    iovs[i] = iovec{buf.data() + (mode == rx_mode::mmsg ? i * k_slot : 0), k_slot};
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control{};
+
+  std::uint64_t packets = 0;
+  std::uint64_t bytes = 0;
+  events evs{4};
+  while (!st.stop.load(std::memory_order_relaxed)) {
+    bool again = false;
+    switch (mode) {
+      case rx_mode::single: {
+        auto r = s.recv_from(buf);
+        if (r.has_value()) {
+          ++packets;
+          bytes += r->first;
+        } else {
+          again = true;
+        }
+        break;
+      }
+      case rx_mode::mmsg: {
+        const int n = ::recvmmsg(s.raw_fd(), msgs.data(), static_cast<unsigned>(batch), 0, nullptr);
+        if (n > 0) {
+          packets += static_cast<std::uint64_t>(n);
+          for (int i = 0; i < n; ++i) {
+            bytes += msgs[static_cast<std::size_t>(i)].msg_len;
+          }
+        } else {
+          again = true;
+        }
+        break;
+      }
+      case rx_mode::gro: {
+        msghdr mh{};
+        mh.msg_iov = iovs.data();
+        mh.msg_iovlen = 1;
+        mh.msg_control = control.data();
+        mh.msg_controllen = control.size();
+        const ssize_t n = ::recvmsg(s.raw_fd(), &mh, 0);
+        if (n > 0) {
+          // A coalesced read carries the segment size; the last segment
+          // may be short.
+          std::size_t seg = static_cast<std::size_t>(n);
+          for (auto* c = CMSG_FIRSTHDR(&mh); c != nullptr; c = CMSG_NXTHDR(&mh, c)) {
+            if (c->cmsg_level == SOL_UDP && c->cmsg_type == UDP_GRO) {
+              int v = 0;
+              std::memcpy(&v, CMSG_DATA(c), sizeof(v));
+              seg = v > 0 ? static_cast<std::size_t>(v) : seg;
+            }
+          }
+          packets += (static_cast<std::size_t>(n) + seg - 1) / seg;
+          bytes += static_cast<std::size_t>(n);
+        } else {
+          again = true;
+        }
+        break;
+      }
+    }
+    if (again) {
+      (void)p->do_poll(evs, 10ms);
+    }
+  }
+  st.received.fetch_add(packets, std::memory_order_relaxed);
+  st.received_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// Sends as fast as the socket allows until `until`; a full send buffer
+// waits for writability on that flow.
+void transmit(
+  std::vector<net::udp_socket>& flows,
+  const detail::socket_addr& dst,
+  const run_spec& spec,
+  std::size_t batch,
+  clock_type::time_point until,
+  shared_state& st
+) {
+  auto p = poll::create();
+  if (!p.has_value()) {
+    return;
+  }
+  for (std::size_t i = 0; i < flows.size(); ++i) {
+    (void)p->get_registry().register_source(flows[i], token{i}, interest::writable());
+  }
+
+  // GSO sends one buffer of up to 64 segments and 64 KiB.
+  const auto gso_batch = std::max(std::size_t{1}, std::min({batch, std::size_t{64}, std::size_t{65000} / spec.size}));
+  const std::vector<std::byte> payload(spec.size * std::max(batch, gso_batch), std::byte{'u'});
+  std::vector<iovec> iovs(batch);
+  std::vector<mmsghdr> msgs(batch);
+  for (std::size_t i = 0; i < batch; ++i) {
+    iovs[i] = iovec{const_cast<std::byte*>(payload.data()), spec.size};
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  std::uint64_t sent = 0;
+  std::size_t next = 0;
+  events evs{16};
+  while (clock_type::now() < until) {
+    const auto& s = flows[next++ % flows.size()];
+    bool full = false;
+    switch (spec.tx) {
+      case tx_mode::single: {
+        for (std::size_t i = 0; i < batch && !full; ++i) {
+          auto r = s.send_to(std::span{payload}.first(spec.size), dst);
+          full = !r.has_value();
+          sent += r.has_value() ? 1 : 0;
+        }
+        break;
+      }
+      case tx_mode::mmsg: {
+        const int n = ::sendmmsg(s.raw_fd(), msgs.data(), static_cast<unsigned>(batch), MSG_NOSIGNAL);
+        full = n <= 0;
+        sent += n > 0 ? static_cast<std::uint64_t>(n) : 0;
+        break;
+      }
+      case tx_mode::gso: {
+        auto r = s.send(std::span{payload}.first(spec.size * gso_batch));
+        full = !r.has_value();
+        sent += r.has_value() ? gso_batch : 0;
+        break;
+      }
+    }
+    if (full) {
+      (void)p->do_poll(evs, 1ms);
+    }
+  }
+  st.sent.fetch_add(sent, std::memory_order_relaxed);
+}
+
+auto run(const run_spec& spec, const config& cfg) -> result<run_result> {
+  std::vector<net::udp_socket> rx;
+  auto addr = detail::socket_addr::ipv4_loopback(0);
+  for (std::size_t i = 0; i < spec.sockets; ++i) {
+    auto s = bind_receiver(addr, spec.sockets > 1, cfg.rcvbuf);
+    if (!s.has_value()) {
+      return std::unexpected{s.error()};
+    }
+    if (spec.rx == rx_mode::gro) {
+      if (auto r = set_int_opt(s->raw_fd(), SOL_UDP, UDP_GRO, 1); !r.has_value()) {
+        return std::unexpected{r.error()};
+      }
+    }
+    if (i == 0) {
+      auto local = s->local_addr();
+      if (!local.has_value()) {
+        return std::unexpected{local.error()};
+      }
+      addr = *local;
+    }
+    rx.push_back(std::move(*s));
+  }
+
+  std::vector<std::vector<net::udp_socket>> tx(cfg.tx_threads);
+  for (auto& flows : tx) {
+    for (std::size_t f = 0; f < cfg.flows; ++f) {
+      auto s = net::udp_socket::bind(detail::socket_addr::ipv4_loopback(0));
+      if (!s.has_value()) {
+        return std::unexpected{s.error()};
+      }
+      if (auto r = s->connect(addr); !r.has_value()) {
+        return std::unexpected{r.error()};
+      }
+      if (spec.tx == tx_mode::gso) {
+        if (auto r = set_int_opt(s->raw_fd(), SOL_UDP, UDP_SEGMENT, static_cast<int>(spec.size));
+            !r.has_value()) {
+          return std::unexpected{r.error()};
+        }
+      }
+      flows.push_back(std::move(*s));
+    }
+  }
+
+  shared_state st;
+  const auto drops_before = rcvbuf_errors();
+  std::vector<std::thread> threads;
+  for (auto& s : rx) {
+    threads.emplace_back([&] { receive(s, spec.rx, cfg.batch, st); });
+  }
+
+  const auto start = clock_type::now();
+  const auto until = start + cfg.duration;
+  std::vector<std::thread> senders;
+  for (auto& flows : tx) {
+    senders.emplace_back([&] { transmit(flows, addr, spec, cfg.batch, until, st); });
+  }
+  for (auto& t : senders) {
+    t.join();
+  }
+  const auto elapsed = clock_type::now() - start;
+
+  // Let the receivers drain what is already queued before stopping them.
+  std::this_thread::sleep_for(50ms);
+  st.stop.store(true, std::memory_order_relaxed);
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  return run_result{
+    .sent = st.sent.load(),
+    .received = st.received.load(),
+    .received_bytes = st.received_bytes.load(),
+    .rcvbuf_errors = rcvbuf_errors() - drops_before,
+    .elapsed = elapsed,
+  };
+}
+
+void print_row(const run_spec& spec, const result<run_result>& r) {
+  std::print("{:<7} {:<7} {:>5} {:>6} ", name(spec.tx), name(spec.rx), spec.sockets, spec.size);
+  if (!r.has_value()) {
+    std::println(" n/a ({})", r.error());
+    return;
+  }
+  const auto secs = r->elapsed.count();
+  const auto lost = r->sent > r->received ? r->sent - r->received : 0;
+  const auto drop_pct = r->sent == 0 ? 0.0 : 100.0 * static_cast<double>(lost) / static_cast<double>(r->sent);
+  std::println("{:>12.0f} {:>12.0f} {:>10.1f} {:>7.2f} {:>12}", static_cast<double>(r->sent) / secs,
+               static_cast<double>(r->received) / secs,
+               static_cast<double>(r->received_bytes) * 8.0 / secs / 1e6, drop_pct, r->rcvbuf_errors);
+}
+
+auto parse_list(std::string_view v, std::vector<std::size_t>& out) -> bool {
+  out.clear();
+  while (!v.empty()) {
+    const auto comma = v.find(',');
+    const auto item = v.substr(0, comma);
+    if (std::from_chars(item.data(), item.data() + item.size(), out.emplace_back()).ec != std::errc{}
+        || out.back() == 0) {
+      return false;
+    }
+    v = comma == std::string_view::npos ? std::string_view{} : v.substr(comma + 1);
+  }
+  return !out.empty();
+}
+
+template <typename t_t>
+auto parse_num(std::string_view s, t_t& out) -> bool {
+  return std::from_chars(s.data(), s.data() + s.size(), out).ec == std::errc{};
+}
+
+auto parse_args(int argc, char* argv[], config& cfg) -> bool {
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view a{argv[i]};
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const std::string_view v{argv[++i]};
+    long ms = 0;
+    if (a == "-s") {
+      if (!parse_list(v, cfg.sizes)) {
+        return false;
+      }
+    } else if (a == "--tx") {
+      if (v == "single") {
+        cfg.tx = tx_mode::single;
+      } else if (v == "mmsg") {
+        cfg.tx = tx_mode::mmsg;
+      } else if (v == "gso") {
+        cfg.tx = tx_mode::gso;
+      } else {
+        return false;
+      }
+    } else if (a == "--rx") {
+      if (v == "single") {
+        cfg.rx = rx_mode::single;
+      } else if (v == "mmsg") {
+        cfg.rx = rx_mode::mmsg;
+      } else if (v == "gro") {
+        cfg.rx = rx_mode::gro;
+      } else {
+        return false;
+      }
+    } else if (a == "-r") {
+      if (!parse_num(v, cfg.rx_sockets)) {
+        return false;
+      }
+    } else if (a == "-t") {
+      if (!parse_num(v, cfg.tx_threads)) {
+        return false;
+      }
+    } else if (a == "-f") {
+      if (!parse_num(v, cfg.flows)) {
+        return false;
+      }
+    } else if (a == "-b") {
+      if (!parse_num(v, cfg.batch)) {
+        return false;
+      }
+    } else if (a == "--rcvbuf") {
+      if (!parse_num(v, cfg.rcvbuf)) {
+        return false;
+      }
+    } else if (a == "-d") {
+      if (!parse_num(v, ms)) {
+        return false;
+      }
+      cfg.duration = std::chrono::milliseconds{ms};
+    } else {
+      return false;
+    }
+  }
+  return cfg.rx_sockets > 0 && cfg.tx_threads > 0 && cfg.flows > 0 && cfg.batch > 0 && cfg.batch <= 1024
+         && cfg.duration.count() > 0;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+  config cfg;
+  if (!parse_args(argc, argv, cfg)) {
+    std::println(
+      stderr,
+      "usage: {} [-s 64,512,1400] [--tx single|mmsg|gso] [--rx single|mmsg|gro] [-r rx_sockets] "
+      "[-t tx_threads] [-f flows] [-b batch] [--rcvbuf bytes] [-d millis]",
+      argv[0]
+    );
+    return 2;
+  }
+
+  std::vector<std::pair<tx_mode, rx_mode>> modes;
+  if (cfg.tx.has_value() || cfg.rx.has_value()) {
+    modes.emplace_back(cfg.tx.value_or(tx_mode::single), cfg.rx.value_or(rx_mode::single));
+  } else {
+    modes = {{tx_mode::single, rx_mode::single}, {tx_mode::mmsg, rx_mode::mmsg}, {tx_mode::gso, rx_mode::gro}};
+  }
+  std::vector<std::size_t> socket_counts{1};
+  if (cfg.rx_sockets > 1) {
+    socket_counts.push_back(cfg.rx_sockets);
+  }
+
+  std::println("loopback udp, {} sender threads x {} flows, batch {}, {} ms per row", cfg.tx_threads, cfg.flows,
+               cfg.batch, cfg.duration.count());
+  std::println("{:<7} {:<7} {:>5} {:>6} {:>12} {:>12} {:>10} {:>7} {:>12}", "tx", "rx", "socks", "size",
+               "sent pps", "recv pps", "recv Mbps", "drop %", "rcvbuf errs");
+  for (const auto size : cfg.sizes) {
+    for (const auto [tx, rx] : modes) {
+      for (const auto n : socket_counts) {
+        const run_spec spec{.tx = tx, .rx = rx, .sockets = n, .size = size};
+        print_row(spec, run(spec, cfg));
+      }
+    }
+  }
+  return 0;
+}